@@ -0,0 +1,332 @@
+#ifndef CACHE_SKIPLIST_H
+#define CACHE_SKIPLIST_H
+
+#include "SkipList.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+// Entrada a desalojar cuando se supera un limite: la menos usada (una
+// lectura la renueva si no esta ya entre la mitad mas reciente) o la mas
+// antigua (solo cuenta la primera insercion).
+enum EvictionPolicy {
+    EVICT_LRU,
+    EVICT_FIFO
+};
+
+// Limites de CacheSkipList; cero es sin limite. bytes se mide con el weigher
+// del constructor (por defecto sizeof(K) + sizeof(V) por entrada).
+struct CacheOptions {
+    size_t maxSize;
+    size_t maxBytes;
+    EvictionPolicy policy;
+
+    CacheOptions() : maxSize(0), maxBytes(0), policy(EVICT_LRU) {}
+};
+
+// SkipList ordenada para usar como cache: cada entrada puede tener un
+// instante de vencimiento y la cantidad de entradas o de bytes puede tener
+// un limite.
+//
+// Una entrada vencida deja de verse en search/find/at/contains y se borra
+// al encontrarla (expiracion perezosa). Las que nadie vuelve a leer se
+// borran con expire_some(now, maxItems), que trabaja como mucho sobre
+// maxItems entradas para que el barrido se pueda repartir en pasos chicos
+// sin picos de latencia. Los vencimientos viven en un segundo indice
+// ordenado por (instante, clave), asi que expire_some solo toca entradas ya
+// vencidas.
+//
+// Al superar un limite se borran primero entradas vencidas y luego las que
+// elige la politica, usando un tercer indice por numero de secuencia que
+// solo se mantiene si hay algun limite.
+//
+// Clock es un reloj como steady_clock (now() estatico); los tests usan uno
+// falso. No es thread-safe: las lecturas modifican la cache.
+template <typename K, typename V, typename Compare = less<K>, typename Clock = chrono::steady_clock>
+class CacheSkipList {
+public:
+    typedef typename Clock::time_point TimePoint;
+    typedef typename Clock::duration Duration;
+    typedef function<size_t(const K&, const V&)> Weigher;
+
+private:
+    struct Entry {
+        V value;
+        TimePoint expiresAt;
+        uint64_t seq;
+        size_t weight;
+        bool expires;
+
+        Entry(const V& v, TimePoint at, uint64_t s, size_t w, bool e)
+            : value(v), expiresAt(at), seq(s), weight(w), expires(e) {}
+    };
+
+    typedef pair<TimePoint, K> ExpiryKey;
+
+    struct ExpiryLess {
+        Compare comp;
+
+        explicit ExpiryLess(const Compare& c = Compare()) : comp(c) {}
+
+        bool operator()(const ExpiryKey& a, const ExpiryKey& b) const {
+            if (a.first < b.first) return true;
+            if (b.first < a.first) return false;
+            return comp(a.second, b.second);
+        }
+    };
+
+    SkipList<K, Entry, Compare> data_;
+    SkipList<ExpiryKey, char, ExpiryLess> expiry_;
+    SkipList<uint64_t, K> order_;
+
+    CacheOptions options_;
+    Weigher weigh_;
+    uint64_t nextSeq_;
+    size_t bytes_;
+    size_t evictions_;
+    size_t expirations_;
+
+    bool bounded() const {
+        return options_.maxSize != 0 || options_.maxBytes != 0;
+    }
+
+    bool overLimit() const {
+        return (options_.maxSize != 0 && data_.size() > options_.maxSize) ||
+               (options_.maxBytes != 0 && bytes_ > options_.maxBytes);
+    }
+
+    static bool expired(const Entry& entry, TimePoint now) {
+        return entry.expires && !(now < entry.expiresAt);
+    }
+
+    // key debe ser una copia: las referencias a claves de los indices se
+    // invalidan al borrar.
+    void erase(const K& key, Entry& entry) {
+        if (entry.expires) {
+            expiry_.remove(ExpiryKey(entry.expiresAt, key));
+        }
+        if (bounded()) {
+            order_.remove(entry.seq);
+        }
+        bytes_ -= entry.weight;
+        data_.remove(key);
+    }
+
+    // LRU aproximado: una entrada entre las mas recientes no se mueve, asi
+    // las lecturas de claves calientes no escriben en el indice.
+    void touch(const K& key, Entry& entry) {
+        if (nextSeq_ - entry.seq <= data_.size() / 2) return;
+        order_.remove(entry.seq);
+        entry.seq = nextSeq_++;
+        order_.insert(entry.seq, key);
+    }
+
+    // Entrada viva de key, o nullptr; borra la entrada si ya vencio
+    Entry* live(const K& key) {
+        auto it = data_.find(key);
+        if (it == data_.end()) {
+            return nullptr;
+        }
+        Entry& entry = it.value();
+        if (entry.expires && expired(entry, Clock::now())) {
+            K copy = it.key();
+            erase(copy, entry);
+            expirations_++;
+            return nullptr;
+        }
+        if (bounded() && options_.policy == EVICT_LRU) {
+            touch(key, entry);
+        }
+        return &entry;
+    }
+
+    // Borra el primer vencimiento si es anterior o igual a now
+    bool expireFront(TimePoint now) {
+        if (expiry_.empty() || now < expiry_.front().key().first) {
+            return false;
+        }
+        ExpiryKey item = expiry_.front().key();
+        erase(item.second, data_.find(item.second).value());
+        expirations_++;
+        return true;
+    }
+
+    void enforceLimits() {
+        if (!overLimit()) return;
+        TimePoint now = Clock::now();
+        while (overLimit()) {
+            if (expireFront(now)) continue;
+            K victim = order_.front().value();
+            erase(victim, data_.find(victim).value());
+            evictions_++;
+        }
+    }
+
+    bool insertEntry(const K& key, const V& value, bool expires, TimePoint expiresAt) {
+        size_t weight = weigh_(key, value);
+        // Aceptarla desalojaria todo, incluida ella misma
+        if (options_.maxBytes != 0 && weight > options_.maxBytes) {
+            throw invalid_argument("La entrada pesa mas que maxBytes");
+        }
+        auto it = data_.find(key);
+        if (it != data_.end()) {
+            Entry& entry = it.value();
+            if (entry.expires) {
+                expiry_.remove(ExpiryKey(entry.expiresAt, key));
+                entry.expires = false;
+            }
+            entry.value = value;
+            if (expires) {
+                expiry_.insert(ExpiryKey(expiresAt, key), 0);
+                entry.expires = true;
+                entry.expiresAt = expiresAt;
+            }
+            bytes_ = bytes_ - entry.weight + weight;
+            entry.weight = weight;
+            if (bounded() && options_.policy == EVICT_LRU) {
+                touch(key, entry);
+            }
+            enforceLimits();
+            return false;
+        }
+
+        uint64_t seq = nextSeq_++;
+        if (expires) {
+            expiry_.insert(ExpiryKey(expiresAt, key), 0);
+        }
+        try {
+            if (bounded()) {
+                order_.insert(seq, key);
+            }
+            data_.insert(key, Entry(value, expiresAt, seq, weight, expires));
+        } catch (...) {
+            if (expires) expiry_.remove(ExpiryKey(expiresAt, key));
+            if (bounded()) order_.remove(seq);
+            throw;
+        }
+        bytes_ += weight;
+        enforceLimits();
+        return true;
+    }
+
+public:
+    explicit CacheSkipList(const CacheOptions& options = CacheOptions(), Weigher weigh = nullptr,
+                           const Compare& comp = Compare())
+        : data_(16, 0.5f, comp)
+        , expiry_(16, 0.5f, ExpiryLess(comp))
+        , options_(options)
+        , weigh_(weigh)
+        , nextSeq_(0)
+        , bytes_(0)
+        , evictions_(0)
+        , expirations_(0) {
+        if (!weigh_) {
+            weigh_ = [](const K&, const V&) { return sizeof(K) + sizeof(V); };
+        }
+    }
+
+    // Inserta o sobrescribe sin vencimiento; devuelve true si la clave era
+    // nueva. Sobrescribir reemplaza tambien el vencimiento. Lanza
+    // invalid_argument si la entrada sola pesa mas que maxBytes; en ese caso
+    // la cache no cambia.
+    bool insert(const K& key, const V& value) {
+        return insertEntry(key, value, false, TimePoint());
+    }
+
+    // Vence ttl despues de Clock::now()
+    bool insert(const K& key, const V& value, Duration ttl) {
+        return insertEntry(key, value, true, Clock::now() + ttl);
+    }
+
+    bool insert_until(const K& key, const V& value, TimePoint expiresAt) {
+        return insertEntry(key, value, true, expiresAt);
+    }
+
+    bool search(const K& key, V& value) {
+        Entry* entry = live(key);
+        if (entry == nullptr) {
+            return false;
+        }
+        value = entry->value;
+        return true;
+    }
+
+    // Puntero al valor, o nullptr; valido hasta la siguiente modificacion
+    V* find(const K& key) {
+        Entry* entry = live(key);
+        return entry == nullptr ? nullptr : &entry->value;
+    }
+
+    V& at(const K& key) {
+        Entry* entry = live(key);
+        if (entry == nullptr) {
+            throw out_of_range("Clave no encontrada en CacheSkipList");
+        }
+        return entry->value;
+    }
+
+    bool contains(const K& key) {
+        return live(key) != nullptr;
+    }
+
+    bool remove(const K& key) {
+        auto it = data_.find(key);
+        if (it == data_.end()) {
+            return false;
+        }
+        erase(key, it.value());
+        return true;
+    }
+
+    // Borra hasta maxItems entradas vencidas en now, las de vencimiento mas
+    // antiguo primero. Devuelve cuantas borro; menos de maxItems significa
+    // que no quedan vencidas.
+    size_t expire_some(TimePoint now, size_t maxItems) {
+        size_t removed = 0;
+        while (removed < maxItems && expireFront(now)) {
+            removed++;
+        }
+        return removed;
+    }
+
+    // Entradas guardadas, incluidas las vencidas que aun no se borraron
+    size_t size() const noexcept {
+        return data_.size();
+    }
+
+    bool empty() const noexcept {
+        return data_.empty();
+    }
+
+    size_t bytes() const noexcept {
+        return bytes_;
+    }
+
+    // Entradas borradas por los limites y por vencimiento. Son acumulados
+    // desde la construccion: clear() no los reinicia.
+    size_t evictions() const noexcept {
+        return evictions_;
+    }
+
+    size_t expirations() const noexcept {
+        return expirations_;
+    }
+
+    const CacheOptions& options() const noexcept {
+        return options_;
+    }
+
+    void clear() {
+        data_.clear();
+        expiry_.clear();
+        order_.clear();
+        bytes_ = 0;
+        nextSeq_ = 0;
+    }
+};
+
+#endif
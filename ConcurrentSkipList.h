@@ -0,0 +1,398 @@
+#ifndef CONCURRENT_SKIPLIST_H
+#define CONCURRENT_SKIPLIST_H
+
+#include "EpochReclamation.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+// Skip list concurrente sin locks (Herlihy & Shavit / Fraser). Cada enlace es
+// un puntero atomico cuyo bit bajo marca el nodo como borrado logicamente;
+// los nodos marcados se desenlazan con CAS durante las busquedas y se liberan
+// a traves de EpochManager.
+//
+// A diferencia de SkipList::insert, insert() no sobrescribe un valor existente:
+// los valores son inmutables una vez publicados, lo que permite leerlos sin
+// locks.
+template <typename K, typename V>
+class ConcurrentSkipList {
+public:
+    static const int MAX_LEVEL = 32;
+
+private:
+    struct Node {
+        K key;
+        V value;
+        int level;
+        // Referencias pendientes: una del hilo que enlaza la torre y otra de
+        // la pertenencia a la lista. Quien la deja en cero retira el nodo.
+        atomic<int> refs;
+
+        Node(const K& k, const V& v, int lvl) : key(k), value(v), level(lvl), refs(2) {}
+    };
+
+    typedef atomic<uintptr_t> Link;
+
+    // Bloque de un nodo: [Node | padding | Link torre[level + 1]], igual que SkipList
+    static constexpr size_t towerOffset() {
+        return (sizeof(Node) + alignof(Link) - 1) / alignof(Link) * alignof(Link);
+    }
+
+    static size_t nodeBytes(int level) {
+        return towerOffset() + static_cast<size_t>(level + 1) * sizeof(Link);
+    }
+
+    static Link* tower(Node* node) {
+        return reinterpret_cast<Link*>(reinterpret_cast<char*>(node) + towerOffset());
+    }
+
+    static bool isMarked(uintptr_t link) {
+        return (link & 1) != 0;
+    }
+
+    static Node* pointer(uintptr_t link) {
+        return reinterpret_cast<Node*>(link & ~static_cast<uintptr_t>(1));
+    }
+
+    static uintptr_t encode(Node* node, bool marked = false) {
+        return reinterpret_cast<uintptr_t>(node) | (marked ? 1 : 0);
+    }
+
+    static Node* createNode(const K& key, const V& value, int level) {
+        void* mem = ::operator new(nodeBytes(level));
+        Node* node;
+        try {
+            node = ::new (mem) Node(key, value, level);
+        } catch (...) {
+            ::operator delete(mem);
+            throw;
+        }
+        Link* links = tower(node);
+        for (int i = 0; i <= level; i++) {
+            ::new (&links[i]) Link(0);
+        }
+        return node;
+    }
+
+    static void destroyNode(void* ptr) {
+        Node* node = static_cast<Node*>(ptr);
+        node->~Node();
+        ::operator delete(ptr);
+    }
+
+    // El header no construye K ni V: solo su torre.
+    static Link* createHeader() {
+        void* mem = ::operator new(static_cast<size_t>(MAX_LEVEL + 1) * sizeof(Link));
+        Link* links = static_cast<Link*>(mem);
+        for (int i = 0; i <= MAX_LEVEL; i++) {
+            ::new (&links[i]) Link(0);
+        }
+        return links;
+    }
+
+    Link* head_;
+    atomic<int> height_;
+    atomic<size_t> size_;
+    float probability_;
+    int maxPossibleLevel_;
+
+    int randomLevel() const {
+        static thread_local mt19937 rng(random_device{}() ^
+                                        static_cast<unsigned>(hash<thread::id>()(this_thread::get_id())));
+        uniform_real_distribution<float> dist(0.0f, 1.0f);
+        int level = 0;
+        while (dist(rng) < probability_ && level < maxPossibleLevel_) {
+            level++;
+        }
+        return level;
+    }
+
+    Link* linksOf(Node* node) const {
+        return node == nullptr ? head_ : tower(node);
+    }
+
+    void release(Node* node) {
+        if (node->refs.fetch_sub(1, memory_order_acq_rel) == 1) {
+            EpochManager::instance().retire(node, &ConcurrentSkipList::destroyNode);
+        }
+    }
+
+    // Busca la posicion de key en cada nivel y desenlaza los nodos marcados
+    // que encuentra en el camino. preds[i] == nullptr representa el header.
+    // Debe llamarse dentro de un EpochGuard.
+    bool find(const K& key, Node** preds, Node** succs) {
+    retry:
+        Node* pred = nullptr;
+        for (int i = height_.load(memory_order_acquire); i >= 0; i--) {
+            Node* curr = pointer(linksOf(pred)[i].load(memory_order_acquire));
+            while (curr != nullptr) {
+                uintptr_t succ = tower(curr)[i].load(memory_order_acquire);
+                while (isMarked(succ)) {
+                    uintptr_t expected = encode(curr);
+                    if (!linksOf(pred)[i].compare_exchange_strong(expected, encode(pointer(succ)),
+                                                                 memory_order_acq_rel)) {
+                        goto retry;
+                    }
+                    curr = pointer(succ);
+                    if (curr == nullptr) break;
+                    succ = tower(curr)[i].load(memory_order_acquire);
+                }
+                if (curr == nullptr || !(curr->key < key)) break;
+                pred = curr;
+                curr = pointer(succ);
+            }
+            preds[i] = pred;
+            succs[i] = curr;
+        }
+        return succs[0] != nullptr && !(key < succs[0]->key);
+    }
+
+    // Marca los enlaces de victim de arriba abajo. Devuelve true solo para el
+    // hilo que marca el nivel 0, que es el que lo borra.
+    static bool markRemoved(Node* victim) {
+        for (int i = victim->level; i >= 1; i--) {
+            uintptr_t succ = tower(victim)[i].load(memory_order_acquire);
+            while (!isMarked(succ)) {
+                tower(victim)[i].compare_exchange_weak(succ, succ | 1, memory_order_acq_rel);
+            }
+        }
+
+        uintptr_t succ = tower(victim)[0].load(memory_order_acquire);
+        while (!isMarked(succ)) {
+            if (tower(victim)[0].compare_exchange_strong(succ, succ | 1, memory_order_acq_rel)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void raiseHeight(int level) {
+        int current = height_.load(memory_order_relaxed);
+        while (current < level &&
+               !height_.compare_exchange_weak(current, level, memory_order_acq_rel)) {
+        }
+    }
+
+    // Recorrido de solo lectura: no modifica enlaces, salta los nodos marcados.
+    Node* findLive(const K& key) const {
+        Node* pred = nullptr;
+        Node* curr = nullptr;
+        for (int i = height_.load(memory_order_acquire); i >= 0; i--) {
+            curr = pointer(linksOf(pred)[i].load(memory_order_acquire));
+            while (curr != nullptr) {
+                uintptr_t succ = tower(curr)[i].load(memory_order_acquire);
+                if (isMarked(succ)) {
+                    curr = pointer(succ);
+                    continue;
+                }
+                if (!(curr->key < key)) break;
+                pred = curr;
+                curr = pointer(succ);
+            }
+        }
+        if (curr != nullptr && !(key < curr->key) && !isMarked(tower(curr)[0].load(memory_order_acquire))) {
+            return curr;
+        }
+        return nullptr;
+    }
+
+    void freeAll() {
+        Node* current = pointer(head_[0].load(memory_order_relaxed));
+        while (current != nullptr) {
+            Node* following = pointer(tower(current)[0].load(memory_order_relaxed));
+            destroyNode(current);
+            current = following;
+        }
+    }
+
+public:
+    explicit ConcurrentSkipList(int maxLevel = 16, float probability = 0.5f)
+        : head_(nullptr)
+        , height_(0)
+        , size_(0)
+        , probability_(probability)
+        , maxPossibleLevel_(maxLevel) {
+
+        if (maxLevel < 0 || maxLevel > MAX_LEVEL) {
+            throw invalid_argument("maxLevel debe estar entre 0 y 32");
+        }
+        if (probability <= 0.0f || probability >= 1.0f) {
+            throw invalid_argument("probability debe estar entre 0 y 1 (exclusivo)");
+        }
+
+        head_ = createHeader();
+    }
+
+    // El destructor, como clear(), exige que ningun otro hilo use la lista.
+    ~ConcurrentSkipList() {
+        freeAll();
+        ::operator delete(head_);
+    }
+
+    ConcurrentSkipList(const ConcurrentSkipList&) = delete;
+    ConcurrentSkipList& operator=(const ConcurrentSkipList&) = delete;
+
+    bool insert(const K& key, const V& value) {
+        EpochGuard guard;
+        Node* preds[MAX_LEVEL + 1];
+        Node* succs[MAX_LEVEL + 1];
+        Node* node = nullptr;
+        int level = randomLevel();
+        raiseHeight(level);
+
+        while (true) {
+            if (find(key, preds, succs)) {
+                if (node != nullptr) destroyNode(node);
+                return false;
+            }
+            if (node == nullptr) {
+                node = createNode(key, value, level);
+            }
+            for (int i = 0; i <= level; i++) {
+                tower(node)[i].store(encode(succs[i]), memory_order_relaxed);
+            }
+            uintptr_t expected = encode(succs[0]);
+            if (linksOf(preds[0])[0].compare_exchange_strong(expected, encode(node), memory_order_acq_rel)) {
+                break;
+            }
+        }
+        size_.fetch_add(1, memory_order_relaxed);
+
+        for (int i = 1; i <= level; i++) {
+            bool linked = false;
+            while (!linked) {
+                uintptr_t current = tower(node)[i].load(memory_order_acquire);
+                if (isMarked(current)) goto done;  // borrado mientras se enlazaba
+                if (pointer(current) != succs[i] &&
+                    !tower(node)[i].compare_exchange_strong(current, encode(succs[i]), memory_order_acq_rel)) {
+                    continue;
+                }
+                uintptr_t expected = encode(succs[i]);
+                if (linksOf(preds[i])[i].compare_exchange_strong(expected, encode(node), memory_order_acq_rel)) {
+                    linked = true;
+                } else if (!find(key, preds, succs) || succs[0] != node) {
+                    goto done;
+                }
+            }
+        }
+    done:
+        // Si alguien lo borro durante el enlace, puede haber quedado un enlace
+        // tardio: una busqueda mas lo desenlaza antes de soltar la referencia.
+        if (isMarked(tower(node)[0].load(memory_order_acquire))) {
+            find(key, preds, succs);
+        }
+        release(node);
+        return true;
+    }
+
+    bool remove(const K& key) {
+        EpochGuard guard;
+        Node* preds[MAX_LEVEL + 1];
+        Node* succs[MAX_LEVEL + 1];
+
+        if (!find(key, preds, succs)) {
+            return false;
+        }
+        Node* victim = succs[0];
+        if (!markRemoved(victim)) {
+            return false;  // otro hilo lo borro primero
+        }
+        size_.fetch_sub(1, memory_order_relaxed);
+
+        find(key, preds, succs);  // desenlace fisico
+        release(victim);
+        return true;
+    }
+
+    // Quita el minimo para varios consumidores (por ejemplo, un scheduler):
+    // recorre el nivel 0 desde el header e intenta marcar el primer nodo vivo;
+    // si otro consumidor lo gana, prueba con el siguiente en lugar de volver a
+    // empezar. Copia la clave y el valor en key y value.
+    bool pop_front(K& key, V& value) {
+        EpochGuard guard;
+        Node* curr = pointer(head_[0].load(memory_order_acquire));
+        while (curr != nullptr) {
+            uintptr_t succ = tower(curr)[0].load(memory_order_acquire);
+            if (!isMarked(succ) && markRemoved(curr)) {
+                key = curr->key;
+                value = curr->value;
+                size_.fetch_sub(1, memory_order_relaxed);
+
+                Node* preds[MAX_LEVEL + 1];
+                Node* succs[MAX_LEVEL + 1];
+                find(curr->key, preds, succs);  // desenlace fisico
+                release(curr);
+                return true;
+            }
+            curr = pointer(tower(curr)[0].load(memory_order_acquire));
+        }
+        return false;
+    }
+
+    bool erase(const K& key) {
+        return remove(key);
+    }
+
+    bool contains(const K& key) const {
+        EpochGuard guard;
+        return findLive(key) != nullptr;
+    }
+
+    bool search(const K& key, V& value) const {
+        EpochGuard guard;
+        Node* node = findLive(key);
+        if (node == nullptr) {
+            return false;
+        }
+        value = node->value;
+        return true;
+    }
+
+    // Recorrido en orden, debilmente consistente: ve cada elemento presente
+    // durante toda la llamada y puede o no ver los modificados en paralelo.
+    template <typename F>
+    void for_each(F f) const {
+        EpochGuard guard;
+        Node* current = pointer(head_[0].load(memory_order_acquire));
+        while (current != nullptr) {
+            uintptr_t succ = tower(current)[0].load(memory_order_acquire);
+            if (!isMarked(succ)) {
+                f(static_cast<const K&>(current->key), static_cast<const V&>(current->value));
+            }
+            current = pointer(succ);
+        }
+    }
+
+    // Aproximado mientras haya escrituras en curso.
+    size_t size() const noexcept {
+        return size_.load(memory_order_relaxed);
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    int maxLevel() const noexcept {
+        return height_.load(memory_order_relaxed);
+    }
+
+    // Solo valido sin otros hilos usando la lista.
+    void clear() {
+        freeAll();
+        for (int i = 0; i <= MAX_LEVEL; i++) {
+            head_[i].store(0, memory_order_relaxed);
+        }
+        height_.store(0, memory_order_relaxed);
+        size_.store(0, memory_order_relaxed);
+    }
+};
+
+#endif
@@ -0,0 +1,492 @@
+#ifndef DURABLE_SKIPLIST_H
+#define DURABLE_SKIPLIST_H
+
+#include "SkipList.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#endif
+
+using namespace std;
+
+// Parametros del group commit: el hilo que hace el fsync (lider) espera hasta
+// groupCommitDelay a que otros escritores agreguen registros, o hasta que haya
+// groupCommitBytes pendientes, y los sincroniza todos juntos. Con delay cero
+// solo se agrupan los registros que llegan mientras hay un fsync en curso.
+// Con sync = false los registros se escriben al sistema operativo sin fsync.
+struct DurableOptions {
+    size_t groupCommitBytes;
+    chrono::microseconds groupCommitDelay;
+    bool sync;
+
+    DurableOptions() : groupCommitBytes(1 << 20), groupCommitDelay(0), sync(true) {}
+};
+
+// SkipList con write-ahead log: cada insert/remove/clear se agrega al log
+// (path + ".wal") y solo retorna cuando el registro es durable. Al abrir se
+// carga el ultimo checkpoint (path + ".snap", en el formato de save()) y se
+// reaplica el log; un registro final truncado o con checksum invalido (una
+// escritura que no termino antes de la caida) se descarta y se corta del log.
+// checkpoint() guarda la lista y vacia el log.
+//
+// Es segura entre hilos: un mutex protege la lista y el buffer del log, y se
+// suelta durante la escritura y el fsync para que otros escritores se sumen
+// al siguiente grupo. Los cambios se aplican a la lista despues de ser
+// durables y en el orden del log, asi que las lecturas (que devuelven
+// copias) solo ven datos durables. Si falla la escritura del log, el grupo
+// no se aplica y la lista pasa a rechazar modificaciones.
+template <typename K, typename V, typename Compare = less<K>>
+class DurableSkipList {
+private:
+    enum : uint8_t { OP_INSERT = 1, OP_REMOVE = 2, OP_CLEAR = 3 };
+
+    // Cabecera del log y de cada registro. Los registros ocupan un multiplo
+    // de 8 bytes: [RecordHeader | clave y valor con skiplist_codec | relleno
+    // | checksum de 64 bits de todo lo anterior].
+    struct LogHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t keySize;
+        uint32_t valueSize;
+    };
+
+    struct RecordHeader {
+        uint32_t payloadBytes;
+        uint8_t op;
+        uint8_t reserved[3];
+    };
+
+    static const uint32_t LOG_VERSION = 1;
+
+    SkipList<K, V, Compare> list_;
+    string path_;
+    DurableOptions options_;
+    int fd_;
+
+    mutable mutex mutex_;
+    condition_variable flushed_;
+    string pending_;
+    uint64_t appendSeq_;
+    uint64_t durableSeq_;
+    map<uint64_t, bool> results_;
+    bool flushing_;
+    bool failed_;
+    uint64_t logBytes_;
+    uint64_t syncs_;
+    size_t recovered_;
+    size_t discarded_;
+
+    string snapPath() const { return path_ + ".snap"; }
+    string logPath() const { return path_ + ".wal"; }
+
+    static LogHeader makeLogHeader() {
+        LogHeader header;
+        memcpy(header.magic, "SKWL", 4);
+        header.version = LOG_VERSION;
+        header.keySize = static_cast<uint32_t>(sizeof(K));
+        header.valueSize = static_cast<uint32_t>(sizeof(V));
+        return header;
+    }
+
+    static bool writeAll(int fd, const char* data, size_t bytes) {
+        while (bytes > 0) {
+#if !defined(_WIN32)
+            ssize_t written = ::write(fd, data, bytes);
+#else
+            int written = ::_write(fd, data, static_cast<unsigned>(bytes));
+#endif
+            if (written <= 0) return false;
+            data += written;
+            bytes -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    static bool syncFd(int fd) {
+#if !defined(_WIN32)
+        return ::fsync(fd) == 0;
+#else
+        return ::_commit(fd) == 0;
+#endif
+    }
+
+    static void syncFile(const string& path) {
+#if !defined(_WIN32)
+        int fd = ::open(path.c_str(), O_RDONLY);
+#else
+        int fd = ::_open(path.c_str(), _O_RDWR | _O_BINARY);
+#endif
+        bool ok = fd >= 0 && syncFd(fd);
+        if (fd >= 0) closeFd(fd);
+        if (!ok) {
+            throw runtime_error("No se pudo sincronizar " + path);
+        }
+    }
+
+    // Hace durable un rename: en POSIX la entrada nueva vive en el
+    // directorio, que se sincroniza aparte del archivo. En Windows no aplica.
+    static void syncDirectoryOf(const string& path) {
+#if !defined(_WIN32)
+        size_t slash = path.rfind('/');
+        string dir = slash == string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+        int fd = ::open(dir.c_str(), O_RDONLY);
+        bool ok = fd >= 0 && syncFd(fd);
+        if (fd >= 0) closeFd(fd);
+        if (!ok) {
+            throw runtime_error("No se pudo sincronizar el directorio " + dir);
+        }
+#else
+        (void)path;
+#endif
+    }
+
+    static void closeFd(int fd) {
+#if !defined(_WIN32)
+        ::close(fd);
+#else
+        ::_close(fd);
+#endif
+    }
+
+    // Deja el log con valid bytes y lo abre para agregar al final
+    void openLog(uint64_t valid) {
+#if !defined(_WIN32)
+        fd_ = ::open(logPath().c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        bool ok = fd_ >= 0 && ::ftruncate(fd_, static_cast<off_t>(valid)) == 0;
+#else
+        fd_ = ::_open(logPath().c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+        bool ok = fd_ >= 0 && ::_chsize_s(fd_, static_cast<__int64>(valid)) == 0;
+#endif
+        if (ok && valid == 0) {
+            LogHeader header = makeLogHeader();
+            ok = writeAll(fd_, reinterpret_cast<const char*>(&header), sizeof(header));
+            valid = sizeof(header);
+        }
+        if (ok && options_.sync) ok = syncFd(fd_);
+        if (!ok) {
+            if (fd_ >= 0) closeFd(fd_);
+            fd_ = -1;
+            throw runtime_error("No se pudo abrir el log " + logPath());
+        }
+        logBytes_ = valid;
+    }
+
+    static void appendRecord(string& out, uint8_t op, const K* key, const V* value) {
+        size_t start = out.size();
+        RecordHeader header = {};
+        header.op = op;
+        out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (key != nullptr) skiplist_codec<K>::encode(*key, out);
+        if (value != nullptr) skiplist_codec<V>::encode(*value, out);
+        uint32_t payloadBytes = static_cast<uint32_t>(out.size() - start - sizeof(header));
+        memcpy(&out[start], &payloadBytes, sizeof(payloadBytes));
+        out.append(skiplist_detail::alignUp(out.size() - start, 8) - (out.size() - start), '\0');
+
+        skiplist_detail::Checksum checksum;
+        checksum.update(out.data() + start, out.size() - start);
+        uint64_t sum = checksum.value();
+        out.append(reinterpret_cast<const char*>(&sum), sizeof(sum));
+    }
+
+    // Aplica un registro ya validado; devuelve lo que devolveria la
+    // operacion (clave nueva en insert, clave presente en remove)
+    bool replay(uint8_t op, const char* p, const char* end) {
+        if (op == OP_CLEAR) {
+            list_.clear();
+            return true;
+        }
+        K key = skiplist_codec<K>::decode(p, end);
+        if (op == OP_INSERT) {
+            V value = skiplist_codec<V>::decode(p, end);
+            return list_.insert(key, value);
+        } else if (op == OP_REMOVE) {
+            return list_.remove(key);
+        }
+        throw runtime_error("Registro desconocido en el log de SkipList");
+    }
+
+    // Aplica a list_, en orden, un grupo ya durable cuyo primer registro es
+    // first, y guarda el resultado de cada uno para quien lo escribio.
+    void applyBatch(const string& batch, uint64_t first) {
+        size_t offset = 0;
+        while (offset < batch.size()) {
+            RecordHeader record;
+            memcpy(&record, batch.data() + offset, sizeof(record));
+            size_t body = skiplist_detail::alignUp(sizeof(record) + static_cast<size_t>(record.payloadBytes), 8);
+            const char* payload = batch.data() + offset + sizeof(record);
+            results_[first++] = replay(record.op, payload, payload + record.payloadBytes);
+            offset += body + sizeof(uint64_t);
+        }
+    }
+
+    // Reaplica el log y devuelve cuantos bytes son validos. El log solo
+    // contiene operaciones posteriores al checkpoint anterior, pero si la
+    // caida ocurrio entre guardar el checkpoint y vaciar el log se reaplican
+    // sobre un checkpoint que ya las incluye: como cada operacion deja la
+    // clave en un estado fijo, repetir la secuencia en orden no cambia nada.
+    uint64_t recover() {
+        ifstream probe(snapPath().c_str(), ios::binary);
+        if (probe) {
+            probe.close();
+            list_.load(snapPath());
+        }
+        ifstream logProbe(logPath().c_str(), ios::binary);
+        if (!logProbe) return 0;
+        logProbe.close();
+
+        vector<char> data = skiplist_detail::readFile(logPath());
+        if (data.size() < sizeof(LogHeader)) return 0;
+        LogHeader header;
+        memcpy(&header, data.data(), sizeof(header));
+        LogHeader expected = makeLogHeader();
+        if (memcmp(&header, &expected, sizeof(header)) != 0) {
+            throw runtime_error("El log " + logPath() + " no corresponde a esta SkipList");
+        }
+
+        size_t offset = sizeof(LogHeader);
+        while (offset + sizeof(RecordHeader) <= data.size()) {
+            RecordHeader record;
+            memcpy(&record, data.data() + offset, sizeof(record));
+            size_t body = skiplist_detail::alignUp(sizeof(record) + static_cast<size_t>(record.payloadBytes), 8);
+            if (body + sizeof(uint64_t) > data.size() - offset) break;
+
+            skiplist_detail::Checksum checksum;
+            checksum.update(data.data() + offset, body);
+            uint64_t stored;
+            memcpy(&stored, data.data() + offset + body, sizeof(stored));
+            if (stored != checksum.value()) break;
+
+            const char* payload = data.data() + offset + sizeof(record);
+            replay(record.op, payload, payload + record.payloadBytes);
+            recovered_++;
+            offset += body + sizeof(uint64_t);
+        }
+        discarded_ = data.size() - offset;
+        return offset;
+    }
+
+    // Agrega un registro al grupo pendiente. Requiere el lock.
+    uint64_t append(uint8_t op, const K* key, const V* value) {
+        if (failed_) {
+            throw runtime_error("El log de SkipList fallo; la lista es de solo lectura");
+        }
+        appendRecord(pending_, op, key, value);
+        if (flushing_ && pending_.size() >= options_.groupCommitBytes) {
+            flushed_.notify_all();
+        }
+        return ++appendSeq_;
+    }
+
+    // Espera a que el registro seq sea durable. Si no hay otro hilo
+    // escribiendo, este se vuelve lider: escribe todo lo pendiente y, solo
+    // si la escritura (y el fsync) salio bien, lo aplica a list_. Asi las
+    // lecturas nunca ven datos que no estan en el log, y un fallo deja la
+    // lista como estaba antes del grupo.
+    void commit(uint64_t seq, unique_lock<mutex>& lock) {
+        while (durableSeq_ < seq) {
+            if (failed_) {
+                throw runtime_error("Error escribiendo el log " + logPath());
+            }
+            if (flushing_) {
+                flushed_.wait(lock);
+                continue;
+            }
+            flushing_ = true;
+            if (options_.groupCommitDelay.count() > 0 && pending_.size() < options_.groupCommitBytes) {
+                flushed_.wait_for(lock, options_.groupCommitDelay, [this] {
+                    return pending_.size() >= options_.groupCommitBytes;
+                });
+            }
+            string batch;
+            batch.swap(pending_);
+            uint64_t first = durableSeq_ + 1;
+            uint64_t upTo = appendSeq_;
+
+            lock.unlock();
+            bool ok = writeAll(fd_, batch.data(), batch.size()) && (!options_.sync || syncFd(fd_));
+            lock.lock();
+
+            flushing_ = false;
+            if (ok) {
+                // Si aplicar lanza (sin memoria), list_ ya no coincide con
+                // el log: la lista pasa a solo lectura como con un error de
+                // escritura.
+                try {
+                    applyBatch(batch, first);
+                    durableSeq_ = upTo;
+                    logBytes_ += batch.size();
+                    syncs_++;
+                } catch (...) {
+                    failed_ = true;
+                }
+            } else {
+                failed_ = true;
+            }
+            flushed_.notify_all();
+        }
+    }
+
+    // Resultado del registro seq, ya aplicado por commit
+    bool takeResult(uint64_t seq) {
+        typename map<uint64_t, bool>::iterator it = results_.find(seq);
+        bool result = it->second;
+        results_.erase(it);
+        return result;
+    }
+
+    void drain(unique_lock<mutex>& lock) {
+        commit(appendSeq_, lock);
+    }
+
+public:
+    explicit DurableSkipList(const string& path, const DurableOptions& options = DurableOptions(),
+                             int maxLevel = 16, float probability = 0.5f)
+        : list_(maxLevel, probability)
+        , path_(path)
+        , options_(options)
+        , fd_(-1)
+        , appendSeq_(0)
+        , durableSeq_(0)
+        , flushing_(false)
+        , failed_(false)
+        , logBytes_(0)
+        , syncs_(0)
+        , recovered_(0)
+        , discarded_(0) {
+        openLog(recover());
+    }
+
+    ~DurableSkipList() {
+        unique_lock<mutex> lock(mutex_);
+        try {
+            drain(lock);
+        } catch (...) {
+        }
+        closeFd(fd_);
+    }
+
+    DurableSkipList(const DurableSkipList&) = delete;
+    DurableSkipList& operator=(const DurableSkipList&) = delete;
+
+    // Inserta o actualiza; retorna true si la clave no existia. Los cambios
+    // se ven en la lista recien cuando son durables; si el log falla se
+    // lanza runtime_error y la lista no cambia.
+    bool insert(const K& key, const V& value) {
+        unique_lock<mutex> lock(mutex_);
+        uint64_t seq = append(OP_INSERT, &key, &value);
+        commit(seq, lock);
+        return takeResult(seq);
+    }
+
+    bool remove(const K& key) {
+        unique_lock<mutex> lock(mutex_);
+        // Sin registros en vuelo, list_ es el estado final y se puede
+        // evitar escribir un remove que no cambia nada
+        if (appendSeq_ == durableSeq_ && !list_.contains(key)) {
+            return false;
+        }
+        uint64_t seq = append(OP_REMOVE, &key, nullptr);
+        commit(seq, lock);
+        return takeResult(seq);
+    }
+
+    bool erase(const K& key) {
+        return remove(key);
+    }
+
+    void clear() {
+        unique_lock<mutex> lock(mutex_);
+        uint64_t seq = append(OP_CLEAR, nullptr, nullptr);
+        commit(seq, lock);
+        takeResult(seq);
+    }
+
+    bool search(const K& key, V& value) const {
+        lock_guard<mutex> lock(mutex_);
+        return list_.search(key, value);
+    }
+
+    bool contains(const K& key) const {
+        lock_guard<mutex> lock(mutex_);
+        return list_.contains(key);
+    }
+
+    V at(const K& key) const {
+        lock_guard<mutex> lock(mutex_);
+        return list_.at(key);
+    }
+
+    // Recorre en orden con el lock tomado; f no debe usar esta lista
+    template <typename F>
+    void for_each(F f) const {
+        lock_guard<mutex> lock(mutex_);
+        for (auto it = list_.cbegin(); it != list_.cend(); ++it) {
+            f(it.key(), it.value());
+        }
+    }
+
+    // Guarda la lista en path + ".snap" (escribiendo a un temporal que se
+    // renombra) y vacia el log. Bloquea a los escritores mientras dura.
+    // El log solo se vacia cuando el rename ya es durable (fsync del
+    // directorio); si algo falla antes, el log anterior queda intacto.
+    void checkpoint() {
+        unique_lock<mutex> lock(mutex_);
+        drain(lock);
+        string tmp = snapPath() + ".tmp";
+        list_.save(tmp);
+        if (options_.sync) syncFile(tmp);
+#if defined(_WIN32)
+        ::remove(snapPath().c_str());
+#endif
+        if (::rename(tmp.c_str(), snapPath().c_str()) != 0) {
+            ::remove(tmp.c_str());
+            throw runtime_error("No se pudo reemplazar " + snapPath());
+        }
+        if (options_.sync) syncDirectoryOf(snapPath());
+        closeFd(fd_);
+        fd_ = -1;
+        openLog(0);
+    }
+
+    size_t size() const {
+        lock_guard<mutex> lock(mutex_);
+        return list_.size();
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    // Registros reaplicados al abrir y bytes descartados al final del log
+    size_t recovered_records() const noexcept { return recovered_; }
+    size_t discarded_bytes() const noexcept { return discarded_; }
+
+    uint64_t log_bytes() const {
+        lock_guard<mutex> lock(mutex_);
+        return logBytes_;
+    }
+
+    // Cantidad de grupos escritos (un fsync por grupo con sync = true)
+    uint64_t log_syncs() const {
+        lock_guard<mutex> lock(mutex_);
+        return syncs_;
+    }
+};
+
+#endif
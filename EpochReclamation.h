@@ -0,0 +1,226 @@
+#ifndef EPOCH_RECLAMATION_H
+#define EPOCH_RECLAMATION_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+// Reclamacion de memoria por epocas (EBR, Fraser 2004) para las estructuras
+// concurrentes. Un hilo que lee punteros compartidos lo hace dentro de un
+// EpochGuard; los nodos desenlazados se entregan con retire() y solo se liberan
+// cuando la epoca global avanzo dos veces, es decir, cuando ningun hilo que
+// pudiera verlos sigue dentro de una seccion critica.
+//
+// enter() publica el estado del lector y luego hace un fence seq_cst;
+// tryAdvance() hace otro antes de leer los registros. Los dos fences se
+// emparejan: o el recorrido ve al lector activo, o el lector ya ve todo lo
+// escrito antes del recorrido, incluido el desenlace de los nodos retirados.
+class EpochManager {
+private:
+    typedef void (*Deleter)(void*);
+
+    struct Retired {
+        void* ptr;
+        Deleter deleter;
+        uint64_t epoch;
+    };
+
+    // Un registro por hilo. Nunca se libera: al terminar el hilo queda libre
+    // para que lo reutilice otro.
+    struct ThreadRecord {
+        atomic<uint64_t> state;  // (epoca << 1) | 1 mientras esta activo
+        atomic<bool> inUse;
+        ThreadRecord* next;
+        int nesting;
+        vector<Retired> retired;
+        // Tamaño de retired que dispara el proximo collect(). Crece al doble de
+        // lo que quedo pendiente para que, si un hilo detenido frena la epoca,
+        // cada retire() no vuelva a recorrer toda la lista.
+        size_t collectAt;
+
+        ThreadRecord() : state(0), inUse(true), next(nullptr), nesting(0), collectAt(COLLECT_THRESHOLD) {}
+    };
+
+    struct ThreadHandle {
+        ThreadRecord* record;
+
+        ThreadHandle() : record(nullptr) {}
+
+        ~ThreadHandle() {
+            if (record != nullptr) {
+                EpochManager::instance().detach(record);
+            }
+        }
+    };
+
+    static const size_t COLLECT_THRESHOLD = 64;
+
+    atomic<uint64_t> globalEpoch_;
+    atomic<ThreadRecord*> records_;
+    mutex orphansMutex_;
+    vector<Retired> orphans_;
+
+    EpochManager() : globalEpoch_(2), records_(nullptr) {}
+
+    ~EpochManager() {
+        // Fin del programa: ya no quedan lectores.
+        for (size_t i = 0; i < orphans_.size(); i++) {
+            orphans_[i].deleter(orphans_[i].ptr);
+        }
+        ThreadRecord* rec = records_.load();
+        while (rec != nullptr) {
+            ThreadRecord* following = rec->next;
+            for (size_t i = 0; i < rec->retired.size(); i++) {
+                rec->retired[i].deleter(rec->retired[i].ptr);
+            }
+            delete rec;
+            rec = following;
+        }
+    }
+
+    ThreadRecord* acquireRecord() {
+        for (ThreadRecord* rec = records_.load(memory_order_acquire); rec != nullptr; rec = rec->next) {
+            bool expected = false;
+            if (!rec->inUse.load(memory_order_relaxed) &&
+                rec->inUse.compare_exchange_strong(expected, true, memory_order_acq_rel)) {
+                return rec;
+            }
+        }
+        ThreadRecord* rec = new ThreadRecord();
+        ThreadRecord* head = records_.load(memory_order_relaxed);
+        do {
+            rec->next = head;
+        } while (!records_.compare_exchange_weak(head, rec, memory_order_release, memory_order_relaxed));
+        return rec;
+    }
+
+    ThreadRecord* localRecord() {
+        static thread_local ThreadHandle handle;
+        if (handle.record == nullptr) {
+            handle.record = acquireRecord();
+        }
+        return handle.record;
+    }
+
+    void detach(ThreadRecord* rec) {
+        rec->state.store(0, memory_order_release);
+        {
+            lock_guard<mutex> lock(orphansMutex_);
+            orphans_.insert(orphans_.end(), rec->retired.begin(), rec->retired.end());
+        }
+        rec->retired.clear();
+        rec->collectAt = COLLECT_THRESHOLD;
+        rec->nesting = 0;
+        rec->inUse.store(false, memory_order_release);
+    }
+
+    bool tryAdvance() {
+        uint64_t epoch = globalEpoch_.load(memory_order_acquire);
+        // Pareja del fence de enter()
+        atomic_thread_fence(memory_order_seq_cst);
+        for (ThreadRecord* rec = records_.load(memory_order_acquire); rec != nullptr; rec = rec->next) {
+            uint64_t state = rec->state.load(memory_order_acquire);
+            if ((state & 1) != 0 && (state >> 1) != epoch) {
+                return false;
+            }
+        }
+        return globalEpoch_.compare_exchange_strong(epoch, epoch + 1, memory_order_acq_rel);
+    }
+
+    static void freeExpired(vector<Retired>& retired, uint64_t epoch) {
+        size_t kept = 0;
+        for (size_t i = 0; i < retired.size(); i++) {
+            if (retired[i].epoch + 2 <= epoch) {
+                retired[i].deleter(retired[i].ptr);
+            } else {
+                retired[kept++] = retired[i];
+            }
+        }
+        retired.resize(kept);
+    }
+
+public:
+    EpochManager(const EpochManager&) = delete;
+    EpochManager& operator=(const EpochManager&) = delete;
+
+    static EpochManager& instance() {
+        static EpochManager manager;
+        return manager;
+    }
+
+    void enter() {
+        ThreadRecord* rec = localRecord();
+        if (rec->nesting++ == 0) {
+            uint64_t epoch = globalEpoch_.load(memory_order_relaxed);
+            rec->state.store((epoch << 1) | 1, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+        }
+    }
+
+    void exit() {
+        ThreadRecord* rec = localRecord();
+        if (--rec->nesting == 0) {
+            rec->state.store(0, memory_order_release);
+        }
+    }
+
+    // El puntero ya debe ser inalcanzable para lectores que entren despues.
+    void retire(void* ptr, Deleter deleter) {
+        ThreadRecord* rec = localRecord();
+        Retired entry = { ptr, deleter, globalEpoch_.load(memory_order_seq_cst) };
+        rec->retired.push_back(entry);
+        if (rec->retired.size() >= rec->collectAt) {
+            collect();
+        }
+    }
+
+    // Intenta avanzar la epoca y libera lo que ya no puede ser observado.
+    void collect() {
+        ThreadRecord* rec = localRecord();
+        tryAdvance();
+        uint64_t epoch = globalEpoch_.load(memory_order_acquire);
+        freeExpired(rec->retired, epoch);
+        size_t threshold = rec->retired.size() * 2;
+        rec->collectAt = threshold > COLLECT_THRESHOLD ? threshold : static_cast<size_t>(COLLECT_THRESHOLD);
+
+        unique_lock<mutex> lock(orphansMutex_, try_to_lock);
+        if (lock.owns_lock()) {
+            freeExpired(orphans_, epoch);
+        }
+    }
+
+    // Libera todo lo retirado por el hilo actual. Solo es valido si ningun otro
+    // hilo esta dentro de una seccion critica (por ejemplo, en un destructor).
+    void quiesce() {
+        for (int i = 0; i < 3; i++) {
+            tryAdvance();
+        }
+        collect();
+    }
+
+    size_t pending() {
+        size_t count = localRecord()->retired.size();
+        lock_guard<mutex> lock(orphansMutex_);
+        return count + orphans_.size();
+    }
+};
+
+// Seccion critica RAII: mientras existe, los nodos retirados no se liberan.
+class EpochGuard {
+public:
+    EpochGuard() {
+        EpochManager::instance().enter();
+    }
+
+    ~EpochGuard() {
+        EpochManager::instance().exit();
+    }
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+#endif
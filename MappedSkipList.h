@@ -0,0 +1,222 @@
+#ifndef MAPPED_SKIPLIST_H
+#define MAPPED_SKIPLIST_H
+
+#include "SkipList.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Vista de solo lectura sobre un archivo de SkipList::save() en formato
+// FORMAT_RAW: el archivo se mapea en memoria (mmap) y las busquedas se hacen
+// directamente sobre la columna de claves, sin deserializar ni reservar
+// nodos, asi que abrirlo cuesta O(1) y solo se leen las paginas que se
+// tocan. Las claves estan ordenadas y son contiguas, por lo que la busqueda
+// es binaria en lugar de por niveles. En Windows el archivo se lee completo
+// a memoria.
+//
+// El constructor valida la cabecera y el tamaño; verify() recorre el archivo
+// para comprobar el checksum y que las claves esten en orden segun Compare.
+// El archivo no guarda su comparador: Compare debe ser el mismo que uso
+// save(), y verify() es lo que detecta un archivo escrito con otro orden.
+template <typename K, typename V, typename Compare = less<K>>
+class MappedSkipList {
+private:
+    static_assert(is_trivially_copyable<K>::value && is_trivially_copyable<V>::value,
+                  "MappedSkipList requiere claves y valores trivialmente copiables");
+
+    const char* data_;
+    size_t bytes_;
+    skiplist_detail::FileHeader header_;
+    const K* keys_;
+    const V* values_;
+    const uint8_t* levels_;
+    Compare comp_;
+
+    void unmap() {
+        if (data_ == nullptr) return;
+#if !defined(_WIN32)
+        munmap(const_cast<char*>(data_), bytes_);
+#else
+        ::operator delete(const_cast<char*>(data_));
+#endif
+        data_ = nullptr;
+    }
+
+    void map(const string& path) {
+#if !defined(_WIN32)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw runtime_error("No se pudo abrir " + path);
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            throw runtime_error("Archivo de SkipList truncado");
+        }
+        bytes_ = static_cast<size_t>(st.st_size);
+        void* mem = mmap(nullptr, bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED) {
+            throw runtime_error("No se pudo mapear " + path);
+        }
+        data_ = static_cast<const char*>(mem);
+#else
+        vector<char> contents = skiplist_detail::readFile(path);
+        bytes_ = contents.size();
+        char* mem = static_cast<char*>(::operator new(bytes_ == 0 ? 1 : bytes_));
+        copy(contents.begin(), contents.end(), mem);
+        data_ = mem;
+#endif
+    }
+
+    size_t lowerIndex(const K& key) const {
+        return static_cast<size_t>(std::lower_bound(keys_, keys_ + size(), key, comp_) - keys_);
+    }
+
+public:
+    class Iterator {
+    private:
+        const MappedSkipList* list_;
+        size_t index_;
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = pair<const K&, const V&>;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type*;
+        using reference = value_type;
+
+        Iterator(const MappedSkipList* list, size_t index) : list_(list), index_(index) {}
+
+        reference operator*() const {
+            return {list_->keys_[index_], list_->values_[index_]};
+        }
+
+        Iterator& operator++() {
+            index_++;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return index_ != other.index_;
+        }
+
+        const K& key() const { return list_->keys_[index_]; }
+        const V& value() const { return list_->values_[index_]; }
+        int level() const { return list_->levels_[index_]; }
+    };
+
+    explicit MappedSkipList(const string& path, const Compare& comp = Compare())
+        : data_(nullptr), bytes_(0), keys_(nullptr), values_(nullptr), levels_(nullptr), comp_(comp) {
+        map(path);
+        try {
+            header_ = skiplist_detail::readHeader(data_, bytes_, skiplist_detail::FORMAT_RAW, sizeof(K), sizeof(V));
+        } catch (...) {
+            unmap();
+            throw;
+        }
+        skiplist_detail::RawLayout layout(header_.count, sizeof(K), sizeof(V));
+        keys_ = reinterpret_cast<const K*>(data_ + layout.keys);
+        values_ = reinterpret_cast<const V*>(data_ + layout.values);
+        levels_ = reinterpret_cast<const uint8_t*>(data_ + layout.levels);
+    }
+
+    ~MappedSkipList() {
+        unmap();
+    }
+
+    MappedSkipList(const MappedSkipList&) = delete;
+    MappedSkipList& operator=(const MappedSkipList&) = delete;
+
+    // Lee todo el archivo y lanza runtime_error si el checksum no coincide
+    void verify() const {
+        skiplist_detail::verifyChecksum(data_, header_);
+        for (size_t i = 1; i < size(); i++) {
+            if (!comp_(keys_[i - 1], keys_[i])) {
+                throw runtime_error("Archivo de SkipList corrupto: claves fuera de orden");
+            }
+        }
+    }
+
+    bool search(const K& key, V& value) const {
+        size_t idx = lowerIndex(key);
+        if (idx == size() || comp_(key, keys_[idx])) {
+            return false;
+        }
+        value = values_[idx];
+        return true;
+    }
+
+    bool contains(const K& key) const {
+        size_t idx = lowerIndex(key);
+        return idx < size() && !comp_(key, keys_[idx]);
+    }
+
+    const V& at(const K& key) const {
+        size_t idx = lowerIndex(key);
+        if (idx == size() || comp_(key, keys_[idx])) {
+            throw out_of_range("Clave no encontrada en MappedSkipList");
+        }
+        return values_[idx];
+    }
+
+    Iterator find(const K& key) const {
+        size_t idx = lowerIndex(key);
+        return idx < size() && !comp_(key, keys_[idx]) ? Iterator(this, idx) : end();
+    }
+
+    Iterator lower_bound(const K& key) const {
+        return Iterator(this, lowerIndex(key));
+    }
+
+    // Posicion de key (numero de claves menores), como SkipList::rank
+    size_t rank(const K& key) const {
+        return lowerIndex(key);
+    }
+
+    Iterator select(size_t index) const {
+        return Iterator(this, index < size() ? index : size());
+    }
+
+    size_t size() const noexcept {
+        return static_cast<size_t>(header_.count);
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    Iterator begin() const {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() const {
+        return Iterator(this, size());
+    }
+};
+
+#endif
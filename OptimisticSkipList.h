@@ -0,0 +1,331 @@
+#ifndef OPTIMISTIC_SKIPLIST_H
+#define OPTIMISTIC_SKIPLIST_H
+
+#include "SkipList.h"
+#include "EpochReclamation.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+// Skip list para cargas con muchas mas lecturas que escrituras. Las
+// escrituras (insert, remove, clear) se serializan con un mutex, como en la
+// lazy skip list de Herlihy et al. pero con un unico lock; las lecturas no
+// toman locks ni escriben memoria compartida: recorren enlaces atomicos
+// publicados con release dentro de un EpochGuard.
+//
+// Un nodo borrado se marca antes de desenlazarlo y se libera a traves de
+// EpochManager, asi que un lector que ya estaba sobre el sigue teniendo
+// enlaces validos. Sobrescribir un valor publica una copia nueva y retira la
+// anterior: el valor que devuelve una lectura nunca se modifica en su lugar.
+template <typename K, typename V, typename Compare = less<K>>
+class OptimisticSkipList {
+public:
+    static const int MAX_LEVEL = 32;
+
+private:
+    // El primer valor vive en el bloque del nodo; los que lo reemplazan, en
+    // el heap.
+    struct Node {
+        K key;
+        int level;
+        atomic<bool> removed;
+        atomic<const V*> value;
+        typename aligned_storage<sizeof(V), alignof(V)>::type storage;
+
+        Node(const K& k, const V& v, int lvl) : key(k), level(lvl), removed(false), value(nullptr) {
+            ::new (&storage) V(v);
+            value.store(inlineValue(), memory_order_relaxed);
+        }
+
+        ~Node() {
+            const V* current = value.load(memory_order_relaxed);
+            if (current != inlineValue()) delete current;
+            inlineValue()->~V();
+        }
+
+        const V* inlineValue() const { return reinterpret_cast<const V*>(&storage); }
+    };
+
+    typedef atomic<Node*> Link;
+
+    // Bloque de un nodo: [Node | padding | Link torre[level + 1]], igual que SkipList
+    static constexpr size_t towerOffset() {
+        return (sizeof(Node) + alignof(Link) - 1) / alignof(Link) * alignof(Link);
+    }
+
+    static size_t nodeBytes(int level) {
+        return towerOffset() + static_cast<size_t>(level + 1) * sizeof(Link);
+    }
+
+    static Link* tower(Node* node) {
+        return reinterpret_cast<Link*>(reinterpret_cast<char*>(node) + towerOffset());
+    }
+
+    static Node* createNode(const K& key, const V& value, int level) {
+        void* mem = ::operator new(nodeBytes(level));
+        Node* node;
+        try {
+            node = ::new (mem) Node(key, value, level);
+        } catch (...) {
+            ::operator delete(mem);
+            throw;
+        }
+        Link* links = tower(node);
+        for (int i = 0; i <= level; i++) {
+            ::new (&links[i]) Link(nullptr);
+        }
+        return node;
+    }
+
+    static void destroyNode(void* ptr) {
+        Node* node = static_cast<Node*>(ptr);
+        node->~Node();
+        ::operator delete(ptr);
+    }
+
+    static void destroyValue(void* ptr) {
+        delete static_cast<V*>(ptr);
+    }
+
+    // El header no construye K: solo su torre.
+    static Link* createHeader() {
+        void* mem = ::operator new(static_cast<size_t>(MAX_LEVEL + 1) * sizeof(Link));
+        Link* links = static_cast<Link*>(mem);
+        for (int i = 0; i <= MAX_LEVEL; i++) {
+            ::new (&links[i]) Link(nullptr);
+        }
+        return links;
+    }
+
+    Compare comp_;
+    Link* head_;
+    atomic<int> height_;
+    atomic<size_t> size_;
+    int maxPossibleLevel_;
+
+    mutex writeMutex_;
+    GeometricLevelGenerator levelGen_;
+
+    Link* linksOf(Node* node) const {
+        return node == nullptr ? head_ : tower(node);
+    }
+
+    // Primer nodo con clave >= key. preds[i] == nullptr representa el header.
+    // Devuelve el sucesor ya comparado: releer el enlace podria dar un nodo
+    // insertado despues, con clave menor.
+    Node* findNode(const K& key, Node** preds = nullptr) const {
+        Node* pred = nullptr;
+        Node* candidate = nullptr;
+        for (int i = height_.load(memory_order_acquire); i >= 0; i--) {
+            while ((candidate = linksOf(pred)[i].load(memory_order_acquire)) != nullptr &&
+                   comp_(candidate->key, key)) {
+                pred = candidate;
+            }
+            if (preds) preds[i] = pred;
+        }
+        return candidate;
+    }
+
+    // Un nodo marcado ya no esta en la lista aunque el lector lo alcance
+    Node* findLive(const K& key) const {
+        Node* node = findNode(key);
+        return node != nullptr && !comp_(key, node->key) && !node->removed.load(memory_order_acquire)
+                   ? node : nullptr;
+    }
+
+    // Enlaza de abajo arriba; el nodo queda en la lista al publicar el nivel 0.
+    // Debe llamarse con writeMutex_ tomado.
+    void link(Node* node, Node** preds) {
+        int height = height_.load(memory_order_relaxed);
+        for (int i = height + 1; i <= node->level; i++) {
+            preds[i] = nullptr;
+        }
+        for (int i = 0; i <= node->level; i++) {
+            tower(node)[i].store(linksOf(preds[i])[i].load(memory_order_relaxed), memory_order_relaxed);
+        }
+        for (int i = 0; i <= node->level; i++) {
+            linksOf(preds[i])[i].store(node, memory_order_release);
+        }
+        if (node->level > height) {
+            height_.store(node->level, memory_order_release);
+        }
+    }
+
+    void freeAll() {
+        Node* current = head_[0].load(memory_order_relaxed);
+        while (current != nullptr) {
+            Node* following = tower(current)[0].load(memory_order_relaxed);
+            destroyNode(current);
+            current = following;
+        }
+    }
+
+public:
+    explicit OptimisticSkipList(int maxLevel = 16, float probability = 0.5f, const Compare& comp = Compare())
+        : comp_(comp)
+        , head_(nullptr)
+        , height_(0)
+        , size_(0)
+        , maxPossibleLevel_(maxLevel)
+        , levelGen_(probability, random_device{}()) {
+
+        if (maxLevel < 0 || maxLevel > MAX_LEVEL) {
+            throw invalid_argument("maxLevel debe estar entre 0 y 32");
+        }
+        if (probability <= 0.0f || probability >= 1.0f) {
+            throw invalid_argument("probability debe estar entre 0 y 1 (exclusivo)");
+        }
+
+        head_ = createHeader();
+    }
+
+    // Copia el contenido de un SkipList en O(n), enlazando al final en orden.
+    // Si algo lanza, el destructor (el constructor delegado ya termino)
+    // libera lo enlazado.
+    template <typename Alloc, typename LevelGen>
+    explicit OptimisticSkipList(const SkipList<K, V, Compare, Alloc, LevelGen>& source,
+                                int maxLevel = 16, float probability = 0.5f)
+        : OptimisticSkipList(maxLevel, probability, source.key_comp()) {
+        Node* last[MAX_LEVEL + 1];
+        for (int i = 0; i <= MAX_LEVEL; i++) {
+            last[i] = nullptr;
+        }
+        for (auto it = source.cbegin(); it != source.cend(); ++it) {
+            Node* node = createNode(it.key(), it.value(), levelGen_(maxPossibleLevel_));
+            for (int i = 0; i <= node->level; i++) {
+                linksOf(last[i])[i].store(node, memory_order_relaxed);
+                last[i] = node;
+            }
+            if (node->level > height_.load(memory_order_relaxed)) {
+                height_.store(node->level, memory_order_relaxed);
+            }
+            size_.fetch_add(1, memory_order_relaxed);
+        }
+    }
+
+    // Exige que ningun otro hilo use la lista.
+    ~OptimisticSkipList() {
+        freeAll();
+        ::operator delete(head_);
+    }
+
+    OptimisticSkipList(const OptimisticSkipList&) = delete;
+    OptimisticSkipList& operator=(const OptimisticSkipList&) = delete;
+
+    // Inserta o sobrescribe, como SkipList::insert. Devuelve true si la clave
+    // era nueva.
+    bool insert(const K& key, const V& value) {
+        lock_guard<mutex> lock(writeMutex_);
+        Node* preds[MAX_LEVEL + 1];
+        Node* node = findNode(key, preds);
+        if (node != nullptr && !comp_(key, node->key)) {
+            const V* previous = node->value.exchange(new V(value), memory_order_acq_rel);
+            // El valor del bloque se destruye con el nodo
+            if (previous != node->inlineValue()) {
+                EpochManager::instance().retire(const_cast<V*>(previous), &OptimisticSkipList::destroyValue);
+            }
+            return false;
+        }
+        link(createNode(key, value, levelGen_(maxPossibleLevel_)), preds);
+        size_.fetch_add(1, memory_order_relaxed);
+        return true;
+    }
+
+    bool remove(const K& key) {
+        lock_guard<mutex> lock(writeMutex_);
+        Node* preds[MAX_LEVEL + 1];
+        Node* node = findNode(key, preds);
+        if (node == nullptr || comp_(key, node->key)) {
+            return false;
+        }
+        node->removed.store(true, memory_order_release);
+        for (int i = node->level; i >= 0; i--) {
+            linksOf(preds[i])[i].store(tower(node)[i].load(memory_order_relaxed), memory_order_release);
+        }
+        EpochManager::instance().retire(node, &OptimisticSkipList::destroyNode);
+        size_.fetch_sub(1, memory_order_relaxed);
+        return true;
+    }
+
+    bool erase(const K& key) {
+        return remove(key);
+    }
+
+    bool search(const K& key, V& value) const {
+        EpochGuard guard;
+        Node* node = findLive(key);
+        if (node == nullptr) {
+            return false;
+        }
+        value = *node->value.load(memory_order_acquire);
+        return true;
+    }
+
+    bool contains(const K& key) const {
+        EpochGuard guard;
+        return findLive(key) != nullptr;
+    }
+
+    // Copia del valor; lanza out_of_range si no existe
+    V at(const K& key) const {
+        EpochGuard guard;
+        Node* node = findLive(key);
+        if (node == nullptr) {
+            throw out_of_range("Clave no encontrada en OptimisticSkipList");
+        }
+        return *node->value.load(memory_order_acquire);
+    }
+
+    // Recorrido en orden sin locks, debilmente consistente
+    template <typename F>
+    void for_each(F f) const {
+        EpochGuard guard;
+        Node* current = head_[0].load(memory_order_acquire);
+        while (current != nullptr) {
+            if (!current->removed.load(memory_order_acquire)) {
+                f(static_cast<const K&>(current->key), *current->value.load(memory_order_acquire));
+            }
+            current = tower(current)[0].load(memory_order_acquire);
+        }
+    }
+
+    // Aproximado mientras haya escrituras en curso.
+    size_t size() const noexcept {
+        return size_.load(memory_order_relaxed);
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    int maxLevel() const noexcept {
+        return height_.load(memory_order_relaxed);
+    }
+
+    // Seguro con lectores en paralelo: los nodos se retiran, no se liberan
+    void clear() {
+        lock_guard<mutex> lock(writeMutex_);
+        Node* current = head_[0].load(memory_order_relaxed);
+        for (int i = 0; i <= MAX_LEVEL; i++) {
+            head_[i].store(nullptr, memory_order_release);
+        }
+        height_.store(0, memory_order_release);
+        while (current != nullptr) {
+            Node* following = tower(current)[0].load(memory_order_relaxed);
+            current->removed.store(true, memory_order_release);
+            EpochManager::instance().retire(current, &OptimisticSkipList::destroyNode);
+            current = following;
+        }
+        size_.store(0, memory_order_relaxed);
+    }
+};
+
+#endif
@@ -0,0 +1,390 @@
+#ifndef SHARDED_SKIPLIST_H
+#define SHARDED_SKIPLIST_H
+
+#include "SkipList.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Mapa ordenado repartido en varias SkipList, cada una con su propio mutex,
+// para que escritores en distintas partes del espacio de claves no compitan.
+//
+// Con Hash = void (por defecto) el reparto es por rangos: la tabla de rutas
+// guarda las claves de corte y cada shard tiene un rango fijo durante toda
+// su vida. Los shards con mas operaciones se parten por la mediana y, si ya
+// hay maxShards, antes se unen los dos vecinos mas frios; el shard viejo se
+// marca retirado y se publica una tabla nueva (copy-on-write), asi que una
+// operacion que llego al shard retirado simplemente reintenta. Con un Hash
+// (por ejemplo hash<K>) el reparto es por hash, con shards fijos: sirve para
+// cargas de solo busquedas puntuales y no se rebalancea.
+//
+// El recorrido en orden hace un merge de k vias entre los shards. begin()/end()
+// y operator[] (cuya referencia un rebalanceo puede invalidar) solo deben
+// usarse sin otros hilos escribiendo; for_each es seguro en paralelo.
+template <typename K, typename V, typename Compare = less<K>, typename Hash = void>
+class ShardedSkipList {
+public:
+    typedef SkipList<K, V, Compare> List;
+
+    // Operaciones por shard entre revisiones del rebalanceo (potencia de 2)
+    static const uint64_t REBALANCE_INTERVAL = 1 << 14;
+    // Tamaño minimo de un shard para partirlo
+    static const size_t MIN_SPLIT_SIZE = 1024;
+
+private:
+    struct Shard {
+        mutex lock;
+        List list;
+        bool retired;
+        atomic<uint64_t> ops;
+        atomic<size_t> size;
+
+        Shard() : retired(false), ops(0), size(0) {}
+    };
+
+    // Inmutable una vez publicada. Por rangos, shards[i] tiene las claves en
+    // [splits[i - 1], splits[i]).
+    struct Routing {
+        vector<K> splits;
+        vector<shared_ptr<Shard>> shards;
+    };
+
+    typedef integral_constant<bool, is_void<Hash>::value> ByRange;
+    typedef typename conditional<ByRange::value, hash<int>, Hash>::type Hasher;
+
+    // Mutables porque las lecturas tambien pueden disparar un rebalanceo
+    mutable shared_ptr<const Routing> routing_;
+    Compare comp_;
+    Hasher hash_;
+    size_t maxShards_;
+    mutable mutex rebalance_;
+
+    shared_ptr<const Routing> routing() const {
+        return atomic_load(&routing_);
+    }
+
+    size_t shardIndex(const Routing& r, const K& key, true_type) const {
+        return static_cast<size_t>(upper_bound(r.splits.begin(), r.splits.end(), key, comp_) - r.splits.begin());
+    }
+
+    size_t shardIndex(const Routing& r, const K& key, false_type) const {
+        return hash_(key) % r.shards.size();
+    }
+
+    // Ejecuta f(list) con el lock del shard de key tomado. Cada
+    // REBALANCE_INTERVAL operaciones sobre un shard se revisa el rebalanceo,
+    // tambien desde las lecturas.
+    template<typename F>
+    auto withShard(const K& key, F f) const -> decltype(f(declval<List&>())) {
+        while (true) {
+            shared_ptr<const Routing> r = routing();
+            Shard& shard = *r->shards[shardIndex(*r, key, ByRange())];
+            unique_lock<mutex> lock(shard.lock);
+            if (shard.retired) continue;
+            auto result = f(shard.list);
+            shard.size.store(shard.list.size(), memory_order_relaxed);
+            uint64_t ops = shard.ops.fetch_add(1, memory_order_relaxed) + 1;
+            if (ByRange::value && (ops & (REBALANCE_INTERVAL - 1)) == 0) {
+                lock.unlock();
+                tryRebalance();
+            }
+            return result;
+        }
+    }
+
+    // Une los shards index e index + 1 en la tabla r. join solo enlaza las
+    // torres del borde: O(log n) con los locks tomados, sin copiar entradas.
+    void mergeShards(Routing& r, size_t index) const {
+        // Copias: r se reemplaza antes de soltar los locks
+        shared_ptr<Shard> leftOwner = r.shards[index];
+        shared_ptr<Shard> rightOwner = r.shards[index + 1];
+        Shard& left = *leftOwner;
+        Shard& right = *rightOwner;
+        lock_guard<mutex> leftLock(left.lock);
+        lock_guard<mutex> rightLock(right.lock);
+        // Todo lo que reserva memoria va antes de mover nodos, asi una
+        // excepcion deja los shards como estaban
+        shared_ptr<Shard> merged = make_shared<Shard>();
+        shared_ptr<Routing> next = make_shared<Routing>(r);
+        next->splits.erase(next->splits.begin() + static_cast<ptrdiff_t>(index));
+        next->shards.erase(next->shards.begin() + static_cast<ptrdiff_t>(index) + 1);
+        next->shards[index] = merged;
+        left.list.join(right.list);
+        merged->list.swap(left.list);
+        merged->size.store(merged->list.size(), memory_order_relaxed);
+
+        publish(next);
+        left.retired = true;
+        right.retired = true;
+        r = *next;
+    }
+
+    // Parte el shard index por la mediana, que select encuentra en O(log n);
+    // split mueve los nodos sin copiarlos.
+    bool splitShard(Routing& r, size_t index) const {
+        shared_ptr<Shard> owner = r.shards[index];
+        Shard& hot = *owner;
+        lock_guard<mutex> lock(hot.lock);
+        if (hot.list.size() < MIN_SPLIT_SIZE) return false;
+        K middle = hot.list.select(hot.list.size() / 2).key();
+        shared_ptr<Shard> low = make_shared<Shard>();
+        shared_ptr<Shard> high = make_shared<Shard>();
+        shared_ptr<Routing> next = make_shared<Routing>(r);
+        next->splits.insert(next->splits.begin() + static_cast<ptrdiff_t>(index), middle);
+        next->shards[index] = low;
+        next->shards.insert(next->shards.begin() + static_cast<ptrdiff_t>(index) + 1, high);
+        high->list = hot.list.split(middle);
+        low->list.swap(hot.list);
+        low->size.store(low->list.size(), memory_order_relaxed);
+        high->size.store(high->list.size(), memory_order_relaxed);
+
+        // La tabla nueva se publica antes de soltar el lock del shard viejo:
+        // quien lo encuentre retirado ya ve la nueva al reintentar
+        publish(next);
+        hot.retired = true;
+        r = *next;
+        return true;
+    }
+
+    void publish(const shared_ptr<Routing>& next) const {
+        atomic_store(&routing_, shared_ptr<const Routing>(next));
+    }
+
+    void tryRebalance() const {
+        unique_lock<mutex> lock(rebalance_, try_to_lock);
+        if (lock.owns_lock()) rebalanceLocked();
+    }
+
+    // Parte el shard con mas operaciones desde la revision anterior. Con
+    // maxShards shards solo lo hace si tiene mas de 1.5 veces el promedio, y
+    // antes une el par de vecinos con menos operaciones. Requiere rebalance_.
+    void rebalanceLocked() const {
+        Routing r = *routing();
+        size_t count = r.shards.size();
+        vector<uint64_t> ops(count);
+        uint64_t total = 0;
+        for (size_t i = 0; i < count; i++) {
+            ops[i] = r.shards[i]->ops.exchange(0, memory_order_relaxed);
+            total += ops[i];
+        }
+        size_t hot = static_cast<size_t>(max_element(ops.begin(), ops.end()) - ops.begin());
+        if (r.shards[hot]->size.load(memory_order_relaxed) < MIN_SPLIT_SIZE) return;
+
+        if (count >= maxShards_) {
+            if (count < 3 || ops[hot] * count <= total * 3 / 2) return;
+            size_t coldest = count;
+            for (size_t i = 0; i + 1 < count; i++) {
+                if (i == hot || i + 1 == hot) continue;
+                if (coldest == count || ops[i] + ops[i + 1] < ops[coldest] + ops[coldest + 1]) {
+                    coldest = i;
+                }
+            }
+            if (coldest == count) return;
+            mergeShards(r, coldest);
+            if (coldest < hot) hot--;
+        }
+        splitShard(r, hot);
+    }
+
+public:
+    class Iterator {
+    private:
+        typedef typename List::ConstIterator Cursor;
+
+        struct Greater {
+            Compare comp;
+            bool operator()(const pair<Cursor, Cursor>& a, const pair<Cursor, Cursor>& b) const {
+                return comp(b.first.key(), a.first.key());
+            }
+        };
+
+        shared_ptr<const Routing> routing_;
+        vector<pair<Cursor, Cursor>> heap_;
+        Greater greater_;
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = pair<const K&, const V&>;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type*;
+        using reference = value_type;
+
+        Iterator() {}
+
+        Iterator(const shared_ptr<const Routing>& routing, const Compare& comp) : routing_(routing) {
+            greater_.comp = comp;
+            for (size_t i = 0; i < routing_->shards.size(); i++) {
+                const List& list = routing_->shards[i]->list;
+                if (!list.empty()) heap_.push_back(make_pair(list.cbegin(), list.cend()));
+            }
+            make_heap(heap_.begin(), heap_.end(), greater_);
+        }
+
+        reference operator*() const {
+            return {heap_.front().first.key(), heap_.front().first.value()};
+        }
+
+        Iterator& operator++() {
+            pop_heap(heap_.begin(), heap_.end(), greater_);
+            pair<Cursor, Cursor>& top = heap_.back();
+            if (++top.first == top.second) {
+                heap_.pop_back();
+            } else {
+                push_heap(heap_.begin(), heap_.end(), greater_);
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        // Solo compara contra end(): dos iteradores activos no se distinguen
+        bool operator==(const Iterator& other) const {
+            return heap_.empty() == other.heap_.empty() &&
+                   (heap_.empty() || heap_.front().first == other.heap_.front().first);
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+
+        const K& key() const { return heap_.front().first.key(); }
+        const V& value() const { return heap_.front().first.value(); }
+    };
+
+    // Por rangos, shards es el maximo al que llega el rebalanceo (se empieza
+    // con uno); por hash, la cantidad fija de shards.
+    explicit ShardedSkipList(size_t shards = 16, const Compare& comp = Compare(), const Hasher& hasher = Hasher())
+        : comp_(comp), hash_(hasher), maxShards_(shards) {
+        if (shards == 0) {
+            throw invalid_argument("shards debe ser mayor que 0");
+        }
+        shared_ptr<Routing> initial = make_shared<Routing>();
+        size_t initialShards = ByRange::value ? 1 : shards;
+        for (size_t i = 0; i < initialShards; i++) {
+            initial->shards.push_back(make_shared<Shard>());
+        }
+        routing_ = initial;
+    }
+
+    // Por rangos con claves de corte iniciales (ordenadas): splits.size() + 1 shards
+    ShardedSkipList(const vector<K>& splits, size_t maxShards, const Compare& comp = Compare())
+        : comp_(comp), maxShards_(maxShards) {
+        static_assert(ByRange::value, "Las claves de corte solo aplican al reparto por rangos");
+        if (!is_sorted(splits.begin(), splits.end(), comp_)) {
+            throw invalid_argument("Las claves de corte deben estar ordenadas");
+        }
+        shared_ptr<Routing> initial = make_shared<Routing>();
+        initial->splits = splits;
+        for (size_t i = 0; i <= splits.size(); i++) {
+            initial->shards.push_back(make_shared<Shard>());
+        }
+        if (maxShards_ < initial->shards.size()) maxShards_ = initial->shards.size();
+        routing_ = initial;
+    }
+
+    ShardedSkipList(const ShardedSkipList&) = delete;
+    ShardedSkipList& operator=(const ShardedSkipList&) = delete;
+
+    bool insert(const K& key, const V& value) {
+        return withShard(key, [&key, &value](List& list) { return list.insert(key, value); });
+    }
+
+    bool remove(const K& key) {
+        return withShard(key, [&key](List& list) { return list.remove(key); });
+    }
+
+    bool erase(const K& key) {
+        return remove(key);
+    }
+
+    bool search(const K& key, V& value) const {
+        return withShard(key, [&key, &value](const List& list) { return list.search(key, value); });
+    }
+
+    bool contains(const K& key) const {
+        return withShard(key, [&key](const List& list) { return list.contains(key); });
+    }
+
+    // Copia del valor; lanza out_of_range si no existe
+    V at(const K& key) const {
+        return withShard(key, [&key](const List& list) { return list.at(key); });
+    }
+
+    // La referencia se invalida si otro hilo rebalancea: solo sin escrituras
+    // concurrentes
+    V& operator[](const K& key) {
+        return *withShard(key, [&key](List& list) { return &list[key]; });
+    }
+
+    // Recorre en orden con todos los shards bloqueados; f no debe usar esta lista
+    template <typename F>
+    void for_each(F f) const {
+        lock_guard<mutex> rebalance(rebalance_);
+        shared_ptr<const Routing> r = routing();
+        vector<unique_lock<mutex>> locks;
+        for (size_t i = 0; i < r->shards.size(); i++) {
+            locks.push_back(unique_lock<mutex>(r->shards[i]->lock));
+        }
+        for (Iterator it(r, comp_), last; it != last; ++it) {
+            f(it.key(), it.value());
+        }
+    }
+
+    Iterator begin() const {
+        return Iterator(routing(), comp_);
+    }
+
+    Iterator end() const {
+        return Iterator();
+    }
+
+    // Aproximado mientras haya escrituras en curso
+    size_t size() const {
+        shared_ptr<const Routing> r = routing();
+        size_t total = 0;
+        for (size_t i = 0; i < r->shards.size(); i++) {
+            total += r->shards[i]->size.load(memory_order_relaxed);
+        }
+        return total;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    void clear() {
+        lock_guard<mutex> rebalance(rebalance_);
+        shared_ptr<const Routing> r = routing();
+        for (size_t i = 0; i < r->shards.size(); i++) {
+            lock_guard<mutex> lock(r->shards[i]->lock);
+            r->shards[i]->list.clear();
+            r->shards[i]->size.store(0, memory_order_relaxed);
+        }
+    }
+
+    size_t shard_count() const {
+        return routing()->shards.size();
+    }
+
+    // Fuerza una revision del rebalanceo (sin efecto con reparto por hash)
+    void rebalance() {
+        if (!ByRange::value) return;
+        lock_guard<mutex> lock(rebalance_);
+        rebalanceLocked();
+    }
+};
+
+#endif
@@ -9,365 +9,2402 @@
 #include <iterator>
 #include <functional>
 #include <type_traits>
+#include <cmath>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include <exception>
+#include <system_error>
+#include <thread>
 
 using namespace std;
 
-template <typename K, typename V>
+// Compilar con -DSKIPLIST_STATS para que SkipList cuente busquedas, saltos,
+// comparaciones y latencias por operacion (ver SkipList::stats()). Sin la
+// macro los contadores son tipos vacios y no generan codigo.
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SKIPLIST_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define SKIPLIST_PREFETCH(p) ((void)0)
+#endif
+
+namespace skiplist_detail {
+
+// Detecta allocators con liberacion en bloque (ver SlabAllocator.h).
+template <typename A, typename = void>
+struct has_bulk_release : false_type {};
+
+template <typename A>
+struct has_bulk_release<A, decltype(void(declval<A&>().release()),
+                                     void(declval<const A&>().can_release()))> : true_type {};
+
+template <typename A>
+bool canRelease(const A& alloc, true_type) {
+    return alloc.can_release();
+}
+
+template <typename A>
+bool canRelease(const A&, false_type) {
+    return false;
+}
+
+template <typename A>
+void release(A& alloc, true_type) {
+    alloc.release();
+}
+
+template <typename A>
+void release(A&, false_type) {}
+
+// Formato binario de save()/load(), version 1. Cabecera de 64 bytes y, a
+// continuacion, uno de dos cuerpos:
+//   FORMAT_RAW   (K y V trivialmente copiables) columnas alineadas a 64
+//                bytes: claves[count], valores[count], niveles[count] (uint8).
+//                MappedSkipList sirve busquedas directamente sobre ellas.
+//   FORMAT_CODEC secuencia de (nivel uint8, clave, valor) codificados con
+//                skiplist_codec.
+// El cuerpo se rellena con ceros hasta multiplo de 8 y checksum cubre todo el
+// cuerpo. Los datos van en el orden de bytes de la maquina (byteOrder).
+const uint32_t FILE_VERSION = 1;
+const uint32_t FORMAT_RAW = 0;
+const uint32_t FORMAT_CODEC = 1;
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+const size_t FILE_HEADER_BYTES = 64;
+const size_t COLUMN_ALIGN = 64;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t format;
+    uint32_t byteOrder;
+    uint32_t keySize;
+    uint32_t valueSize;
+    uint64_t count;
+    uint64_t payloadBytes;
+    uint64_t checksum;
+};
+
+static_assert(sizeof(FileHeader) <= FILE_HEADER_BYTES, "La cabecera debe caber en 64 bytes");
+
+inline size_t alignUp(size_t offset, size_t align) {
+    return (offset + align - 1) / align * align;
+}
+
+// Posiciones de las columnas de FORMAT_RAW, medidas desde el inicio del archivo
+struct RawLayout {
+    size_t keys;
+    size_t values;
+    size_t levels;
+    size_t end;
+    
+    RawLayout(uint64_t count, size_t keySize, size_t valueSize) {
+        size_t n = static_cast<size_t>(count);
+        keys = FILE_HEADER_BYTES;
+        values = alignUp(keys + n * keySize, COLUMN_ALIGN);
+        levels = alignUp(values + n * valueSize, COLUMN_ALIGN);
+        end = alignUp(levels + n, 8);
+    }
+};
+
+// Checksum por palabras de 64 bits; los bloques deben ser multiplo de 8.
+class Checksum {
+private:
+    uint64_t hash_;
+    
+public:
+    Checksum() : hash_(0xcbf29ce484222325ULL) {}
+    
+    void update(const char* data, size_t bytes) {
+        uint64_t h = hash_;
+        for (size_t i = 0; i < bytes; i += 8) {
+            uint64_t word;
+            memcpy(&word, data + i, 8);
+            h ^= word;
+            h = (h << 29 | h >> 35) * 0x9E3779B97F4A7C15ULL;
+        }
+        hash_ = h;
+    }
+    
+    uint64_t value() const {
+        return hash_ ^ (hash_ >> 32);
+    }
+};
+
+// Escritura con buffer que va calculando el checksum del cuerpo
+class FileWriter {
+private:
+    static const size_t FLUSH_BYTES = 1 << 16;
+    
+    ofstream& out_;
+    string buffer_;
+    Checksum checksum_;
+    uint64_t written_;
+    
+    void flush(bool all) {
+        size_t bytes = all ? buffer_.size() : buffer_.size() / 8 * 8;
+        checksum_.update(buffer_.data(), bytes);
+        out_.write(buffer_.data(), static_cast<streamsize>(bytes));
+        written_ += bytes;
+        buffer_.erase(0, bytes);
+    }
+    
+public:
+    explicit FileWriter(ofstream& out) : out_(out), written_(0) {}
+    
+    void put(const void* data, size_t bytes) {
+        buffer_.append(static_cast<const char*>(data), bytes);
+        if (buffer_.size() >= FLUSH_BYTES) flush(false);
+    }
+    
+    // Rellena con ceros hasta que el offset en el archivo sea multiplo de align
+    void pad(size_t align) {
+        size_t offset = static_cast<size_t>(FILE_HEADER_BYTES + written_) + buffer_.size();
+        buffer_.append(alignUp(offset, align) - offset, '\0');
+    }
+    
+    // Devuelve el tamaño del cuerpo
+    uint64_t finish() {
+        pad(8);
+        flush(true);
+        return written_;
+    }
+    
+    uint64_t checksum() const {
+        return checksum_.value();
+    }
+};
+
+inline void writeHeader(ofstream& out, uint32_t format, size_t keySize, size_t valueSize,
+                        uint64_t count, uint64_t payloadBytes, uint64_t checksum) {
+    char bytes[FILE_HEADER_BYTES] = {};
+    FileHeader header;
+    memcpy(header.magic, "SKPL", 4);
+    header.version = FILE_VERSION;
+    header.format = format;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.keySize = static_cast<uint32_t>(keySize);
+    header.valueSize = static_cast<uint32_t>(valueSize);
+    header.count = count;
+    header.payloadBytes = payloadBytes;
+    header.checksum = checksum;
+    memcpy(bytes, &header, sizeof(header));
+    out.seekp(0);
+    out.write(bytes, FILE_HEADER_BYTES);
+}
+
+// Valida la cabecera contra el formato y el tamaño del archivo
+inline FileHeader readHeader(const char* data, size_t fileBytes, uint32_t format,
+                             size_t keySize, size_t valueSize) {
+    FileHeader header;
+    if (fileBytes < FILE_HEADER_BYTES) {
+        throw runtime_error("Archivo de SkipList truncado");
+    }
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, "SKPL", 4) != 0) {
+        throw runtime_error("El archivo no es una SkipList guardada");
+    }
+    if (header.version != FILE_VERSION) {
+        throw runtime_error("Version de archivo de SkipList no soportada");
+    }
+    if (header.byteOrder != BYTE_ORDER_MARK) {
+        throw runtime_error("Archivo de SkipList con otro orden de bytes");
+    }
+    if (header.format != format || header.keySize != keySize || header.valueSize != valueSize) {
+        throw runtime_error("El archivo de SkipList no corresponde a estos tipos de clave y valor");
+    }
+    if (header.payloadBytes != fileBytes - FILE_HEADER_BYTES || header.payloadBytes % 8 != 0) {
+        throw runtime_error("Archivo de SkipList truncado");
+    }
+    if (format == FORMAT_RAW) {
+        uint64_t maxCount = (fileBytes - FILE_HEADER_BYTES) / (keySize + valueSize + 1);
+        if (header.count > maxCount || RawLayout(header.count, keySize, valueSize).end != fileBytes) {
+            throw runtime_error("Archivo de SkipList truncado");
+        }
+    }
+    return header;
+}
+
+inline void verifyChecksum(const char* data, const FileHeader& header) {
+    Checksum checksum;
+    checksum.update(data + FILE_HEADER_BYTES, static_cast<size_t>(header.payloadBytes));
+    if (checksum.value() != header.checksum) {
+        throw runtime_error("Checksum invalido en archivo de SkipList");
+    }
+}
+
+inline vector<char> readFile(const string& path) {
+    ifstream in(path.c_str(), ios::binary | ios::ate);
+    if (!in) {
+        throw runtime_error("No se pudo abrir " + path);
+    }
+    streamoff bytes = in.tellg();
+    vector<char> data(static_cast<size_t>(bytes));
+    in.seekg(0);
+    if (bytes > 0 && !in.read(&data[0], bytes)) {
+        throw runtime_error("Error leyendo " + path);
+    }
+    return data;
+}
+
+// Contadores de SKIPLIST_STATS. Las latencias van en histogramas log2: el
+// bucket b cuenta operaciones de [2^b, 2^(b+1)) ns (el 0 incluye 0 y 1 ns).
+enum StatOp { STAT_INSERT = 0, STAT_REMOVE = 1, STAT_LOOKUP = 2, STAT_OPS = 3 };
+const int LATENCY_BUCKETS = 32;
+
+#ifdef SKIPLIST_STATS
+struct Counters {
+    uint64_t searches;
+    uint64_t hops;
+    uint64_t maxHops;
+    uint64_t comparisons;
+    uint64_t ops[STAT_OPS];
+    uint64_t latency[STAT_OPS][LATENCY_BUCKETS];
+    
+    Counters() { reset(); }
+    
+    void reset() { memset(this, 0, sizeof(*this)); }
+};
+
+// Cuenta los saltos y comparaciones de una busqueda y los acumula al salir
+class SearchProbe {
+private:
+    Counters& counters_;
+    uint64_t hops_;
+    uint64_t comparisons_;
+    
+public:
+    explicit SearchProbe(Counters& counters) : counters_(counters), hops_(0), comparisons_(0) {}
+    
+    ~SearchProbe() {
+        counters_.searches++;
+        counters_.hops += hops_;
+        counters_.comparisons += comparisons_;
+        if (hops_ > counters_.maxHops) counters_.maxHops = hops_;
+    }
+    
+    // Un avance en el nivel actual (la comparacion fue true)
+    void hop() {
+        hops_++;
+        comparisons_++;
+    }
+    
+    // Fin de un nivel; compared indica si se comparo contra un sucesor
+    void stop(bool compared) {
+        comparisons_ += compared;
+    }
+};
+
+class LatencyProbe {
+private:
+    Counters& counters_;
+    int op_;
+    chrono::steady_clock::time_point start_;
+    
+public:
+    LatencyProbe(Counters& counters, int op)
+        : counters_(counters), op_(op), start_(chrono::steady_clock::now()) {}
+    
+    ~LatencyProbe() {
+        uint64_t ns = static_cast<uint64_t>(
+            chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start_).count());
+        int bucket = 0;
+        while (ns > 1 && bucket < LATENCY_BUCKETS - 1) {
+            ns >>= 1;
+            bucket++;
+        }
+        counters_.ops[op_]++;
+        counters_.latency[op_][bucket]++;
+    }
+};
+#else
+struct Counters {
+    void reset() {}
+};
+
+struct SearchProbe {
+    explicit SearchProbe(Counters&) {}
+    void hop() {}
+    void stop(bool) {}
+};
+
+struct LatencyProbe {
+    LatencyProbe(Counters&, int) {}
+};
+#endif
+
+}
+
+// Codificacion de claves y valores para el formato FORMAT_CODEC de save().
+// Especializar para tipos propios: encode agrega bytes a out y decode los lee
+// desde p (avanzandolo) sin pasar de end.
+template <typename T, typename Enable = void>
+struct skiplist_codec {
+    static_assert(is_trivially_copyable<T>::value,
+                  "Especializar skiplist_codec<T> para tipos no trivialmente copiables");
+    
+    static void encode(const T& value, string& out) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    
+    static T decode(const char*& p, const char* end) {
+        if (static_cast<size_t>(end - p) < sizeof(T)) {
+            throw runtime_error("Archivo de SkipList truncado");
+        }
+        T value;
+        memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        return value;
+    }
+};
+
+template <>
+struct skiplist_codec<string> {
+    static void encode(const string& value, string& out) {
+        uint64_t length = value.size();
+        out.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.append(value);
+    }
+    
+    static string decode(const char*& p, const char* end) {
+        uint64_t length = skiplist_codec<uint64_t>::decode(p, end);
+        if (static_cast<uint64_t>(end - p) < length) {
+            throw runtime_error("Archivo de SkipList truncado");
+        }
+        string value(p, static_cast<size_t>(length));
+        p += length;
+        return value;
+    }
+};
+
+// Generadores de niveles: politica del quinto parametro de SkipList. Reciben
+// la probabilidad y una semilla, y operator()(maxLevel) devuelve un nivel con
+// P(nivel >= L) = p^L, truncado en maxLevel.
+
+// Por defecto: xorshift64* (8 bytes de estado) y una sola extraccion por
+// insercion. Con p = 1/2^k el nivel son los ceros finales de la extraccion
+// divididos por k; con otro p se invierte la geometrica con un logaritmo.
+class GeometricLevelGenerator {
+private:
+    uint64_t state_;
+    int shift_;
+    double invLogP_;
+    
+    uint64_t draw() {
+        state_ ^= state_ >> 12;
+        state_ ^= state_ << 25;
+        state_ ^= state_ >> 27;
+        return state_ * 0x2545F4914F6CDD1DULL;
+    }
+    
+    static int countTrailingZeros(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(bits);
+#else
+        int count = 0;
+        while ((bits & 1) == 0) {
+            bits >>= 1;
+            count++;
+        }
+        return count;
+#endif
+    }
+    
+public:
+    GeometricLevelGenerator(float probability, uint64_t seed) : state_(0), shift_(0), invLogP_(0.0) {
+        this->seed(seed);
+        for (int k = 1; k <= 8; k++) {
+            if (probability == ldexp(1.0f, -k)) shift_ = k;
+        }
+        if (probability > 0.0f && probability < 1.0f) {
+            invLogP_ = 1.0 / log(static_cast<double>(probability));
+        }
+    }
+    
+    void seed(uint64_t seed) {
+        // splitmix64: cualquier semilla, incluida 0, da un estado no nulo
+        uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        state_ = (z ^ (z >> 31)) | 1;
+    }
+    
+    int operator()(int maxLevel) {
+        uint64_t bits = draw();
+        int level;
+        if (shift_ > 0) {
+            level = countTrailingZeros(bits | (uint64_t(1) << 63)) / shift_;
+        } else {
+            double u = static_cast<double>((bits >> 11) + 1) * (1.0 / 9007199254740992.0);
+            level = static_cast<int>(log(u) * invLogP_);
+        }
+        return level < maxLevel ? level : maxLevel;
+    }
+};
+
+// El generador original: mt19937 (unos 5 KB de estado) y un float por nivel.
+class MersenneLevelGenerator {
+private:
+    mt19937 rng_;
+    uniform_real_distribution<float> dist_;
+    float probability_;
+    
+public:
+    MersenneLevelGenerator(float probability, uint64_t seed)
+        : rng_(static_cast<mt19937::result_type>(seed)), dist_(0.0f, 1.0f), probability_(probability) {}
+    
+    void seed(uint64_t seed) {
+        rng_.seed(static_cast<mt19937::result_type>(seed));
+    }
+    
+    int operator()(int maxLevel) {
+        int level = 0;
+        while (dist_(rng_) < probability_ && level < maxLevel) {
+            level++;
+        }
+        return level;
+    }
+};
+
+// Resultado de SkipList::stats(). La estructura y la memoria se calculan
+// siempre; los contadores solo si countersEnabled (SKIPLIST_STATS). Los bytes
+// son los de los bloques de nodos: no incluyen memoria dinamica de K o V.
+struct SkipListStats {
+    bool countersEnabled;
+    size_t size;
+    int maxLevel;
+    vector<size_t> levelNodes;          // nodos enlazados en cada nivel
+    
+    uint64_t searches;                  // recorridos de findNode
+    uint64_t totalHops;
+    uint64_t maxHops;
+    uint64_t comparisons;
+    uint64_t inserts;
+    uint64_t removes;
+    uint64_t lookups;
+    vector<uint64_t> insertLatency;     // histogramas log2 en ns
+    vector<uint64_t> removeLatency;
+    vector<uint64_t> lookupLatency;
+    
+    size_t keyValueBytes;
+    size_t nodeOverheadBytes;           // nivel, backward y relleno de cada nodo
+    size_t towerBytes;
+    size_t spanBytes;
+    size_t headerBytes;
+    size_t totalBytes;                  // reservado, con el redondeo del allocator
+    
+    SkipListStats()
+        : countersEnabled(false), size(0), maxLevel(0), searches(0), totalHops(0), maxHops(0)
+        , comparisons(0), inserts(0), removes(0), lookups(0), keyValueBytes(0)
+        , nodeOverheadBytes(0), towerBytes(0), spanBytes(0), headerBytes(0), totalBytes(0) {}
+    
+    double averageHops() const {
+        return searches == 0 ? 0.0 : static_cast<double>(totalHops) / static_cast<double>(searches);
+    }
+    
+    double comparisonsPerSearch() const {
+        return searches == 0 ? 0.0 : static_cast<double>(comparisons) / static_cast<double>(searches);
+    }
+    
+    // Cota superior en ns del percentil p (0-100) de un histograma log2
+    static uint64_t latencyPercentile(const vector<uint64_t>& histogram, double p) {
+        uint64_t total = 0;
+        for (size_t b = 0; b < histogram.size(); b++) total += histogram[b];
+        if (total == 0) return 0;
+        uint64_t target = static_cast<uint64_t>(ceil(p / 100.0 * static_cast<double>(total)));
+        uint64_t seen = 0;
+        for (size_t b = 0; b < histogram.size(); b++) {
+            seen += histogram[b];
+            if (seen >= target && histogram[b] != 0) return (uint64_t(1) << (b + 1)) - 1;
+        }
+        return (uint64_t(1) << histogram.size()) - 1;
+    }
+    
+    string to_json() const {
+        ostringstream out;
+        out << "{\"counters_enabled\":" << (countersEnabled ? "true" : "false")
+            << ",\"size\":" << size << ",\"max_level\":" << maxLevel
+            << ",\"level_nodes\":";
+        writeArray(out, levelNodes);
+        out << ",\"searches\":" << searches << ",\"avg_hops\":" << averageHops()
+            << ",\"max_hops\":" << maxHops << ",\"comparisons_per_search\":" << comparisonsPerSearch()
+            << ",\"ops\":{\"insert\":" << inserts << ",\"remove\":" << removes
+            << ",\"lookup\":" << lookups << "}"
+            << ",\"latency_ns_log2\":{\"insert\":";
+        writeArray(out, insertLatency);
+        out << ",\"remove\":";
+        writeArray(out, removeLatency);
+        out << ",\"lookup\":";
+        writeArray(out, lookupLatency);
+        out << "},\"memory\":{\"key_value\":" << keyValueBytes
+            << ",\"node_overhead\":" << nodeOverheadBytes << ",\"tower\":" << towerBytes
+            << ",\"spans\":" << spanBytes << ",\"header\":" << headerBytes
+            << ",\"total\":" << totalBytes << "}}";
+        return out.str();
+    }
+    
+private:
+    template <typename T>
+    static void writeArray(ostringstream& out, const vector<T>& values) {
+        out << "[";
+        for (size_t i = 0; i < values.size(); i++) {
+            out << (i == 0 ? "" : ",") << values[i];
+        }
+        out << "]";
+    }
+};
+
+template <typename K, typename V, typename Compare = less<K>, typename Alloc = allocator<pair<const K, V>>,
+          typename LevelGen = GeometricLevelGenerator>
 class SkipList {
+public:
+    // Cota de maxLevel: permite guardar el camino de predecesores en la pila.
+    static const int MAX_LEVEL = 32;
+    
+    // maxLevel = AUTO_LEVEL: la altura maxima de las torres crece con la
+    // lista, alrededor de log_{1/p}(n) + 1, hasta MAX_LEVEL.
+    static const int AUTO_LEVEL = -1;
+    
 private:
-    static_assert(is_copy_constructible<K>::value, "Key type must be copy constructible");
-    static_assert(is_copy_constructible<V>::value, "Value type must be copy constructible");
+    struct Node;
     
-    struct Node {
+    // Cabecera comun a todos los nodos. La torre de punteros no es un miembro:
+    // se reserva en el mismo bloque de memoria, justo despues del objeto.
+    // backward enlaza el nivel 0 hacia atras (nullptr en el primer nodo); en
+    // el header apunta al ultimo nodo.
+    struct NodeBase {
+        int level;
+        Node* backward;
+        
+        explicit NodeBase(int lvl) : level(lvl), backward(nullptr) {}
+    };
+    
+    struct Node : NodeBase {
         K key;
         V value;
-        vector<Node*> forward;
         
-        Node(const K& k, const V& v, int level) 
-            : key(k), value(v), forward(level + 1, nullptr) {}
-        
-        Node(K&& k, V&& v, int level) 
-            : key(move(k)), value(move(v)), forward(level + 1, nullptr) {}
+        // El valor se construye in-place con los argumentos restantes
+        template<typename KK, typename... Args>
+        Node(int level, KK&& k, Args&&... args) 
+            : NodeBase(level), key(std::forward<KK>(k)), value(std::forward<Args>(args)...) {}
+    };
+    
+    // Bloque de un nodo: [Node | padding | Node* torre[level + 1] | size_t spans[level + 1]]
+    //
+    // spans[i] es el numero de posiciones de nivel 0 que salta el enlace
+    // tower[i] (rango del destino menos rango del origen, con rango(header) = 0
+    // y rango(nullptr) = size + 1). Van en un arreglo aparte para que las
+    // busquedas, que solo leen la torre, no toquen mas memoria.
+    static_assert(alignof(size_t) <= alignof(Node*), "spans debe poder seguir a la torre");
+    
+    static constexpr size_t towerOffset() {
+        return (sizeof(Node) + alignof(Node*) - 1) / alignof(Node*) * alignof(Node*);
+    }
+    
+    static size_t nodeBytes(int level) {
+        return towerOffset() + static_cast<size_t>(level + 1) * (sizeof(Node*) + sizeof(size_t));
+    }
+    
+    static Node** tower(NodeBase* node) {
+        return reinterpret_cast<Node**>(reinterpret_cast<char*>(node) + towerOffset());
+    }
+    
+    static size_t* spans(NodeBase* node) {
+        return reinterpret_cast<size_t*>(tower(node) + node->level + 1);
+    }
+    
+    static Node* next(NodeBase* node, int i) {
+        return tower(node)[i];
+    }
+    
+    Node* asNode(NodeBase* node) const {
+        return node == header_ ? nullptr : static_cast<Node*>(node);
+    }
+    
+    // Nodo cuyo backward apunta a node: su sucesor, o el header si es el ultimo
+    NodeBase* backOwner(Node* following) const {
+        return following != nullptr ? following : header_;
+    }
+    
+    // Unidad de reserva: el allocator se reasocia a este tipo y cada nodo ocupa
+    // un numero entero de unidades segun su altura.
+    struct alignas(Node) NodeUnit {
+        unsigned char bytes[alignof(Node)];
     };
     
-    Node* header_;
+    using UnitAlloc = typename allocator_traits<Alloc>::template rebind_alloc<NodeUnit>;
+    using UnitTraits = allocator_traits<UnitAlloc>;
+    
+    static_assert(is_pointer<typename UnitTraits::pointer>::value,
+                  "El allocator debe usar punteros crudos");
+    
+    static size_t nodeUnits(int level) {
+        return (nodeBytes(level) + sizeof(NodeUnit) - 1) / sizeof(NodeUnit);
+    }
+    
+    void* allocateBlock(int level) {
+        return UnitTraits::allocate(alloc_, nodeUnits(level));
+    }
+    
+    void deallocateBlock(void* block, int level) {
+        UnitTraits::deallocate(alloc_, static_cast<NodeUnit*>(block), nodeUnits(level));
+    }
+    
+    template<typename KK, typename... Args>
+    Node* createNode(int level, KK&& key, Args&&... args) {
+        void* mem = allocateBlock(level);
+        Node* node;
+        try {
+            node = ::new (mem) Node(level, std::forward<KK>(key), std::forward<Args>(args)...);
+        } catch (...) {
+            deallocateBlock(mem, level);
+            throw;
+        }
+        Node** links = tower(node);
+        size_t* widths = spans(node);
+        for (int i = 0; i <= level; i++) {
+            links[i] = nullptr;
+            widths[i] = 0;
+        }
+        return node;
+    }
+    
+    void destroyNode(Node* node) {
+        int level = node->level;
+        node->~Node();
+        deallocateBlock(node, level);
+    }
+    
+    // El header solo necesita la torre: no construye K ni V.
+    NodeBase* createHeader(int level) {
+        void* mem = allocateBlock(level);
+        NodeBase* header = ::new (mem) NodeBase(level);
+        Node** links = tower(header);
+        size_t* widths = spans(header);
+        for (int i = 0; i <= level; i++) {
+            links[i] = nullptr;
+            widths[i] = 1;  // lista vacia: header -> nullptr salta una posicion
+        }
+        return header;
+    }
+    
+    void destroyHeader(NodeBase* header) {
+        int level = header->level;
+        header->~NodeBase();
+        deallocateBlock(header, level);
+    }
+    
+    UnitAlloc alloc_;
+    Compare comp_;
+    NodeBase* header_;
     int maxPossibleLevel_;
     float probability_;
     int maxLevel_;
     size_t size_;
     
-    mt19937 rng_;
-    uniform_real_distribution<float> dist_;
+    LevelGen levels_;
+    bool autoLevel_;
+    // Con AUTO_LEVEL, cota actual de los niveles y rango [capLow_, capHigh_)
+    // de tamaños para el que vale; fuera de el se recalcula.
+    int levelCap_;
+    size_t capLow_;
+    size_t capHigh_;
+    
+    // Dedo de insert(hint, ...): predecesores (y sus rangos) de la ultima
+    // clave insertada por ese camino. Cualquier otra modificacion estructural
+    // lo invalida.
+    NodeBase* finger_[MAX_LEVEL + 1];
+    size_t fingerRanks_[MAX_LEVEL + 1];
+    bool fingerValid_;
+    
+    // Contadores de SKIPLIST_STATS; no se copian ni se intercambian con la
+    // lista. Las lecturas const los modifican, asi que con la macro activa
+    // no se pueden hacer lecturas concurrentes sin sincronizar.
+    mutable skiplist_detail::Counters counters_;
+    
+    int randomLevel() {
+        if (!autoLevel_) {
+            return levels_(maxPossibleLevel_);
+        }
+        if (size_ < capLow_ || size_ >= capHigh_) {
+            updateLevelCap();
+        }
+        return levels_(levelCap_);
+    }
+    
+    // levelCap_ = floor(log_{1/p}(n)) + 1, con n >= 1
+    void updateLevelCap() {
+        double base = 1.0 / probability_;
+        double n = static_cast<double>(size_ > 0 ? size_ : 1);
+        int cap = static_cast<int>(floor(log(n) / log(base))) + 1;
+        if (cap >= maxPossibleLevel_) {
+            levelCap_ = maxPossibleLevel_;
+            capLow_ = 0;
+            capHigh_ = static_cast<size_t>(-1);
+            return;
+        }
+        levelCap_ = cap;
+        capLow_ = static_cast<size_t>(ceil(pow(base, cap - 1)));
+        capHigh_ = static_cast<size_t>(ceil(pow(base, cap)));
+        if (capLow_ > size_) capLow_ = 0;
+        if (capHigh_ <= size_) capHigh_ = size_ + 1;
+    }
+    
+    int levelParam() const {
+        return autoLevel_ ? AUTO_LEVEL : maxPossibleLevel_;
+    }
+    
+    void freeList() {
+        Node* current = next(header_, 0);
+        while (current != nullptr) {
+            Node* following = next(current, 0);
+            destroyNode(current);
+            current = following;
+        }
+    }
+    
+    // Destruye nodos y header. Con un allocator de liberacion en bloque los
+    // nodos solo se recorren si K o V tienen destructor no trivial.
+    void destroyAll() {
+        typename skiplist_detail::has_bulk_release<UnitAlloc>::type bulkTag;
+        
+        if (skiplist_detail::canRelease(alloc_, bulkTag)) {
+            if (!is_trivially_destructible<K>::value || !is_trivially_destructible<V>::value) {
+                Node* current = next(header_, 0);
+                while (current != nullptr) {
+                    Node* following = next(current, 0);
+                    current->~Node();
+                    current = following;
+                }
+            }
+            skiplist_detail::release(alloc_, bulkTag);
+        } else {
+            freeList();
+            destroyHeader(header_);
+        }
+        header_ = nullptr;
+    }
+    
+    // Si update no es nulo debe tener capacidad MAX_LEVEL + 1; se rellenan los
+    // niveles 0..maxLevel_.
+    // Con un comparador transparente, Key puede ser cualquier tipo comparable
+    // con K (por ejemplo const char* o string_view para claves string).
+    //
+    // Si ranks no es nulo, ranks[i] recibe el rango de update[i].
+    template<typename Key>
+    Node* findNode(const Key& key, NodeBase** update = nullptr, size_t* ranks = nullptr) const {
+        NodeBase* current = header_;
+        skiplist_detail::SearchProbe probe(counters_);
+        
+        if (ranks) {
+            size_t rank = 0;
+            for (int i = maxLevel_; i >= 0; i--) {
+                Node* candidate;
+                while ((candidate = next(current, i)) != nullptr && comp_(candidate->key, key)) {
+                    probe.hop();
+                    rank += spans(current)[i];
+                    current = candidate;
+                }
+                probe.stop(candidate != nullptr);
+                update[i] = current;
+                ranks[i] = rank;
+            }
+        } else if (update) {
+            for (int i = maxLevel_; i >= 0; i--) {
+                Node* candidate;
+                while ((candidate = next(current, i)) != nullptr && comp_(candidate->key, key)) {
+                    probe.hop();
+                    current = candidate;
+                }
+                probe.stop(candidate != nullptr);
+                update[i] = current;
+            }
+        } else {
+            for (int i = maxLevel_; i >= 0; i--) {
+                Node* candidate;
+                while ((candidate = next(current, i)) != nullptr && comp_(candidate->key, key)) {
+                    probe.hop();
+                    current = candidate;
+                }
+                probe.stop(candidate != nullptr);
+            }
+        }
+        
+        return next(current, 0);
+    }
+    
+    void copyFrom(const SkipList& other) {
+        maxPossibleLevel_ = other.maxPossibleLevel_;
+        probability_ = other.probability_;
+        maxLevel_ = other.maxLevel_;
+        size_ = other.size_;
+        
+        header_ = createHeader(maxPossibleLevel_);
+        
+        if (other.size_ == 0) return;
+        
+        for (int i = 0; i <= maxPossibleLevel_; i++) {
+            spans(header_)[i] = spans(other.header_)[i];
+        }
+        
+        NodeBase* update[MAX_LEVEL + 1];
+        for (int i = 0; i <= maxPossibleLevel_; i++) {
+            update[i] = header_;
+        }
+        Node* otherCurrent = next(other.header_, 0);
+        
+        try {
+            while (otherCurrent != nullptr) {
+                int level = otherCurrent->level;
+                Node* newNode = createNode(level, otherCurrent->key, otherCurrent->value);
+                
+                newNode->backward = asNode(update[0]);
+                for (int i = 0; i <= level; i++) {
+                    tower(update[i])[i] = newNode;
+                    spans(newNode)[i] = spans(otherCurrent)[i];
+                    update[i] = newNode;
+                }
+                header_->backward = newNode;
+                
+                otherCurrent = next(otherCurrent, 0);
+            }
+        } catch (...) {
+            freeList();
+            destroyHeader(header_);
+            throw;
+        }
+    }
+    
+    // Nodo equivalente a key (ni key < nodo ni nodo < key), o nullptr.
+    template<typename Key>
+    Node* findEqual(const Key& key) const {
+        skiplist_detail::LatencyProbe latency(counters_, skiplist_detail::STAT_LOOKUP);
+        Node* node = findNode(key);
+        if (node != nullptr && !comp_(key, node->key)) {
+            return node;
+        }
+        return nullptr;
+    }
+    
+    // Primer nodo estrictamente mayor que key.
+    template<typename Key>
+    Node* findUpper(const Key& key) const {
+        NodeBase* current = header_;
+        for (int i = maxLevel_; i >= 0; i--) {
+            Node* candidate;
+            while ((candidate = next(current, i)) != nullptr && !comp_(key, candidate->key)) {
+                current = candidate;
+            }
+        }
+        return next(current, 0);
+    }
+    
+    template<typename Key>
+    bool searchImpl(const Key& key, V& value) const {
+        Node* node = findEqual(key);
+        if (node == nullptr) {
+            return false;
+        }
+        value = node->value;
+        return true;
+    }
+    
+    template<typename Key>
+    V& atImpl(const Key& key) const {
+        Node* node = findEqual(key);
+        if (node == nullptr) {
+            throw out_of_range("Clave no encontrada en SkipList");
+        }
+        return node->value;
+    }
+    
+    // Con claves unicas el rango equivalente tiene cero o un elemento.
+    template<typename Key>
+    pair<Node*, Node*> equalRangeImpl(const Key& key) const {
+        Node* node = findNode(key);
+        if (node != nullptr && !comp_(key, node->key)) {
+            return make_pair(node, next(node, 0));
+        }
+        return make_pair(node, node);
+    }
+    
+    // Nivel determinista para la posicion (desde 1) de una construccion
+    // balanceada: cuantas veces divide a position la base 1/p.
+    int balancedLevel(size_t position) const {
+        size_t base = static_cast<size_t>(1.0f / probability_ + 0.5f);
+        if (base < 2) base = 2;
+        int level = 0;
+        while (position % base == 0 && level < maxPossibleLevel_) {
+            position /= base;
+            level++;
+        }
+        return level;
+    }
+    
+    // Construccion por el final, como copyFrom: tails[i] es el ultimo nodo de
+    // nivel i y ranks[i] su rango. La lista debe estar vacia al empezar.
+    void beginAppend(NodeBase** tails, size_t* ranks) {
+        for (int i = 0; i <= maxPossibleLevel_; i++) {
+            tails[i] = header_;
+            ranks[i] = 0;
+        }
+    }
+    
+    void appendNode(Node* node, NodeBase** tails, size_t* ranks) {
+        size_t position = size_ + 1;
+        node->backward = asNode(tails[0]);
+        header_->backward = node;
+        for (int i = 0; i <= node->level; i++) {
+            tower(tails[i])[i] = node;
+            spans(tails[i])[i] = position - ranks[i];
+            tails[i] = node;
+            ranks[i] = position;
+        }
+        if (node->level > maxLevel_) {
+            maxLevel_ = node->level;
+        }
+        size_ = position;
+    }
+    
+    // Cierra las torres; los nodos reutilizados pueden traer enlaces viejos
+    void endAppend(NodeBase** tails, const size_t* ranks) {
+        for (int i = 0; i <= maxPossibleLevel_; i++) {
+            tower(tails[i])[i] = nullptr;
+            spans(tails[i])[i] = size_ + 1 - ranks[i];
+        }
+    }
+    
+    // Ultimo nodo de cada nivel y su rango, para seguir agregando al final
+    // con appendNode (O(log n))
+    void findTails(NodeBase** tails, size_t* ranks) const {
+        NodeBase* current = header_;
+        size_t rank = 0;
+        for (int i = maxPossibleLevel_; i >= 0; i--) {
+            if (i <= maxLevel_) {
+                while (next(current, i) != nullptr) {
+                    rank += spans(current)[i];
+                    current = next(current, i);
+                }
+            }
+            tails[i] = current;
+            ranks[i] = rank;
+        }
+    }
+    
+    // Deja la lista vacia sin liberar nodos: quien llama ya se quedo con la
+    // cadena de nivel 0.
+    void detachAll() {
+        for (int i = 0; i <= maxPossibleLevel_; i++) {
+            tower(header_)[i] = nullptr;
+            spans(header_)[i] = 1;
+        }
+        header_->backward = nullptr;
+        maxLevel_ = 0;
+        size_ = 0;
+        fingerValid_ = false;
+    }
     
-    int randomLevel() {
-        int level = 0;
-        while (dist_(rng_) < probability_ && level < maxPossibleLevel_) {
-            level++;
+    // split, join y las operaciones de conjuntos mueven nodos entre listas:
+    // solo es valido si el allocator de una puede liberar los de la otra y
+    // las torres caben en el header.
+    void checkSplice(const SkipList& other) const {
+        if (!(alloc_ == other.alloc_) || other.maxLevel_ > maxPossibleLevel_) {
+            throw invalid_argument("Las listas deben tener allocators iguales y torres que quepan en maxLevel");
         }
-        return level;
     }
     
-    void freeList() {
-        Node* current = header_->forward[0];
-        while (current != nullptr) {
-            Node* next = current->forward[0];
-            delete current;
-            current = next;
+    // Barrido de intersect/subtract: conserva los nodos cuya presencia en
+    // other es inOther y libera el resto, reconstruyendo las torres.
+    void retainIf(const SkipList& other, bool inOther) {
+        Node* a = next(header_, 0);
+        Node* b = next(other.header_, 0);
+        detachAll();
+        NodeBase* tails[MAX_LEVEL + 1];
+        size_t ranks[MAX_LEVEL + 1];
+        beginAppend(tails, ranks);
+        while (a != nullptr) {
+            Node* following = next(a, 0);
+            while (b != nullptr && comp_(b->key, a->key)) {
+                b = next(b, 0);
+            }
+            bool present = b != nullptr && !comp_(a->key, b->key);
+            if (present == inOther) {
+                appendNode(a, tails, ranks);
+            } else {
+                destroyNode(a);
+            }
+            a = following;
         }
+        endAppend(tails, ranks);
     }
     
-    Node* findNode(const K& key, vector<Node*>* update = nullptr) const {
-        Node* current = header_;
+    // Construye en una pasada a partir de pares (clave, valor) en orden no
+    // decreciente. La lista debe estar vacia. Claves repetidas: gana la ultima.
+    template<typename InputIt>
+    void buildSorted(InputIt first, InputIt last, bool balanced) {
+        NodeBase* tails[MAX_LEVEL + 1];
+        size_t ranks[MAX_LEVEL + 1];
+        beginAppend(tails, ranks);
         
-        if (update) {
-            update->resize(maxPossibleLevel_ + 1);
-            for (int i = maxLevel_; i >= 0; i--) {
-                while (current->forward[i] != nullptr && current->forward[i]->key < key) {
-                    current = current->forward[i];
+        Node* tail = nullptr;
+        for (; first != last; ++first) {
+            if (tail != nullptr) {
+                if (comp_(first->first, tail->key)) {
+                    throw invalid_argument("La entrada de assign_sorted no esta ordenada");
+                }
+                if (!comp_(tail->key, first->first)) {
+                    tail->value = first->second;
+                    continue;
                 }
-                (*update)[i] = current;
             }
-        } else {
-            for (int i = maxLevel_; i >= 0; i--) {
-                while (current->forward[i] != nullptr && current->forward[i]->key < key) {
-                    current = current->forward[i];
+            int level = balanced ? balancedLevel(size_ + 1) : randomLevel();
+            tail = createNode(level, first->first, first->second);
+            appendNode(tail, tails, ranks);
+        }
+        endAppend(tails, ranks);
+    }
+
+    // Minimo de elementos por hilo en las operaciones paralelas
+    static const size_t PARALLEL_GRAIN = 4096;
+
+    // threads = 0 usa hardware_concurrency(); nunca mas partes que grupos de
+    // PARALLEL_GRAIN elementos.
+    static unsigned parallelParts(size_t count, unsigned threads) {
+        if (threads == 0) threads = thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+        size_t bySize = count / PARALLEL_GRAIN;
+        if (bySize == 0) bySize = 1;
+        return bySize < threads ? static_cast<unsigned>(bySize) : threads;
+    }
+
+    // Los nodos solo se reservan en paralelo con allocators sin estado, como
+    // std::allocator; SlabAllocator comparte su arena y no es thread-safe.
+    static unsigned allocationParts(size_t count, unsigned threads) {
+        return is_empty<UnitAlloc>::value ? parallelParts(count, threads) : 1;
+    }
+
+    // Ejecuta task(0..parts-1), la parte 0 en el hilo actual. Si no se puede
+    // crear un hilo, las partes que faltan corren aqui. Relanza la primera
+    // excepcion despues de esperar a todas.
+    template<typename Task>
+    static void runParallel(unsigned parts, const Task& task) {
+        vector<exception_ptr> errors(parts);
+        auto run = [&](unsigned s) {
+            try {
+                task(s);
+            } catch (...) {
+                errors[s] = current_exception();
+            }
+        };
+        vector<thread> workers;
+        workers.reserve(parts);
+        unsigned s = 1;
+        try {
+            for (; s < parts; s++) {
+                workers.emplace_back(run, s);
+            }
+        } catch (const system_error&) {
+        }
+        for (unsigned rest = s; rest < parts; rest++) {
+            run(rest);
+        }
+        run(0);
+        for (size_t w = 0; w < workers.size(); w++) {
+            workers[w].join();
+        }
+        for (size_t e = 0; e < errors.size(); e++) {
+            if (errors[e]) rethrow_exception(errors[e]);
+        }
+    }
+
+    // Tramo construido por un hilo: primer y ultimo nodo de cada nivel con
+    // sus rangos locales (desde 1). Los spans internos ya son definitivos;
+    // stitchSegments solo enlaza los extremos.
+    struct Segment {
+        Node* first[MAX_LEVEL + 1];
+        Node* last[MAX_LEVEL + 1];
+        size_t firstRank[MAX_LEVEL + 1];
+        size_t lastRank[MAX_LEVEL + 1];
+        size_t count;
+
+        Segment() : count(0) {
+            for (int i = 0; i <= MAX_LEVEL; i++) {
+                first[i] = nullptr;
+                last[i] = nullptr;
+            }
+        }
+    };
+
+    static void segmentAppend(Segment& seg, Node* node) {
+        size_t position = ++seg.count;
+        node->backward = seg.last[0];
+        for (int i = 0; i <= node->level; i++) {
+            if (seg.last[i] != nullptr) {
+                tower(seg.last[i])[i] = node;
+                spans(seg.last[i])[i] = position - seg.lastRank[i];
+            } else {
+                seg.first[i] = node;
+                seg.firstRank[i] = position;
+            }
+            seg.last[i] = node;
+            seg.lastRank[i] = position;
+        }
+    }
+
+    // Concatena los tramos en orden. La lista debe estar vacia.
+    void stitchSegments(vector<Segment>& segments) {
+        NodeBase* tails[MAX_LEVEL + 1];
+        size_t ranks[MAX_LEVEL + 1];
+        beginAppend(tails, ranks);
+        for (size_t s = 0; s < segments.size(); s++) {
+            Segment& seg = segments[s];
+            if (seg.count == 0) continue;
+            seg.first[0]->backward = asNode(tails[0]);
+            for (int i = 0; i <= maxPossibleLevel_ && seg.first[i] != nullptr; i++) {
+                tower(tails[i])[i] = seg.first[i];
+                spans(tails[i])[i] = size_ + seg.firstRank[i] - ranks[i];
+                tails[i] = seg.last[i];
+                ranks[i] = size_ + seg.lastRank[i];
+                if (i > maxLevel_) maxLevel_ = i;
+            }
+            size_ += seg.count;
+            header_->backward = seg.last[0];
+        }
+        endAppend(tails, ranks);
+    }
+
+    // Libera lo construido por los hilos cuando alguno fallo
+    void freeSegments(vector<Segment>& segments) {
+        for (size_t s = 0; s < segments.size(); s++) {
+            Node* current = segments[s].first[0];
+            while (current != nullptr) {
+                Node* following = next(current, 0);
+                destroyNode(current);
+                current = following;
+            }
+        }
+    }
+
+    // Como copyFrom, pero cada hilo copia un tramo contiguo de other. Los
+    // cortes se buscan bajando por las torres (selectNode), no recorriendo.
+    void parallelCopyFrom(const SkipList& other, unsigned threads) {
+        unsigned parts = allocationParts(other.size_, threads);
+        if (parts <= 1) {
+            copyFrom(other);
+            return;
+        }
+        maxPossibleLevel_ = other.maxPossibleLevel_;
+        probability_ = other.probability_;
+        maxLevel_ = 0;
+        size_ = 0;
+
+        vector<Segment> segments(parts);
+        vector<Node*> starts(parts);
+        for (unsigned s = 0; s < parts; s++) {
+            starts[s] = other.selectNode(other.size_ * s / parts);
+        }
+        header_ = createHeader(maxPossibleLevel_);
+
+        size_t total = other.size_;
+        try {
+            runParallel(parts, [&](unsigned s) {
+                size_t count = total * (s + 1) / parts - total * s / parts;
+                Node* source = starts[s];
+                for (size_t j = 0; j < count; j++) {
+                    segmentAppend(segments[s], createNode(source->level, source->key, source->value));
+                    source = next(source, 0);
+                }
+            });
+        } catch (...) {
+            freeSegments(segments);
+            destroyHeader(header_);
+            throw;
+        }
+        stitchSegments(segments);
+    }
+
+    // buildSorted en dos pasadas paralelas: la primera valida el orden y
+    // cuenta las claves que quedan (la ultima de cada grupo de iguales), la
+    // segunda crea los nodos ya con su posicion final.
+    template<typename RandomIt>
+    void buildSortedParallel(RandomIt first, RandomIt last, bool balanced, unsigned threads) {
+        static_assert(is_base_of<random_access_iterator_tag,
+                                 typename iterator_traits<RandomIt>::iterator_category>::value,
+                      "parallel_from_sorted requiere iteradores de acceso aleatorio");
+        size_t n = static_cast<size_t>(last - first);
+        unsigned parts = allocationParts(n, threads);
+        if (parts <= 1) {
+            buildSorted(first, last, balanced);
+            return;
+        }
+
+        vector<size_t> offsets(parts + 1, 0);
+        runParallel(parts, [&](unsigned s) {
+            size_t kept = 0;
+            for (size_t j = n * s / parts, end = n * (s + 1) / parts; j < end; j++) {
+                if (j + 1 < n) {
+                    if (comp_(first[j + 1].first, first[j].first)) {
+                        throw invalid_argument("La entrada de parallel_from_sorted no esta ordenada");
+                    }
+                    if (!comp_(first[j].first, first[j + 1].first)) continue;
                 }
+                kept++;
+            }
+            offsets[s + 1] = kept;
+        });
+        for (unsigned s = 0; s < parts; s++) {
+            offsets[s + 1] += offsets[s];
+        }
+
+        // El generador no es thread-safe: los niveles aleatorios se sacan
+        // antes, con el mismo size_ que veria buildSorted.
+        vector<uint8_t> levels;
+        if (!balanced) {
+            levels.resize(offsets[parts]);
+            for (size_t j = 0; j < levels.size(); j++) {
+                size_ = j;
+                levels[j] = static_cast<uint8_t>(randomLevel());
             }
+            size_ = 0;
         }
+
+        vector<Segment> segments(parts);
+        try {
+            runParallel(parts, [&](unsigned s) {
+                for (size_t j = n * s / parts, end = n * (s + 1) / parts; j < end; j++) {
+                    if (j + 1 < n && !comp_(first[j].first, first[j + 1].first)) continue;
+                    size_t position = offsets[s] + segments[s].count + 1;
+                    int level = balanced ? balancedLevel(position) : levels[position - 1];
+                    segmentAppend(segments[s], createNode(level, first[j].first, first[j].second));
+                }
+            });
+        } catch (...) {
+            freeSegments(segments);
+            throw;
+        }
+        stitchSegments(segments);
+    }
+
+    // Reparte los elementos con clave en [lo, hi) en tramos contiguos y llama
+    // visit(s, primer nodo, cantidad) para cada uno en su propio hilo.
+    template<typename Visit>
+    void parallelWalk(const K& lo, const K& hi, unsigned threads, const Visit& visit) const {
+        if (!comp_(lo, hi)) return;
+        size_t from = rank(lo);
+        size_t total = rank(hi) - from;
+        if (total == 0) return;
+        unsigned parts = parallelParts(total, threads);
+        vector<Node*> starts(parts);
+        for (unsigned s = 0; s < parts; s++) {
+            starts[s] = selectNode(from + total * s / parts);
+        }
+        runParallel(parts, [&](unsigned s) {
+            visit(s, starts[s], total * (s + 1) / parts - total * s / parts);
+        });
+    }
+
+    int storedLevel(uint8_t level) const {
+        return level > maxPossibleLevel_ ? maxPossibleLevel_ : level;
+    }
+    
+    void checkLoadOrder(const Node* tail, const K& key) const {
+        if (tail != nullptr && !comp_(tail->key, key)) {
+            throw runtime_error("Archivo de SkipList corrupto: claves fuera de orden");
+        }
+    }
+    
+    void saveBody(skiplist_detail::FileWriter& writer, true_type) const {
+        for (Node* n = next(header_, 0); n != nullptr; n = next(n, 0)) {
+            writer.put(&n->key, sizeof(K));
+        }
+        writer.pad(skiplist_detail::COLUMN_ALIGN);
+        for (Node* n = next(header_, 0); n != nullptr; n = next(n, 0)) {
+            writer.put(&n->value, sizeof(V));
+        }
+        writer.pad(skiplist_detail::COLUMN_ALIGN);
+        for (Node* n = next(header_, 0); n != nullptr; n = next(n, 0)) {
+            uint8_t level = static_cast<uint8_t>(n->level);
+            writer.put(&level, 1);
+        }
+    }
+    
+    void saveBody(skiplist_detail::FileWriter& writer, false_type) const {
+        string entry;
+        for (Node* n = next(header_, 0); n != nullptr; n = next(n, 0)) {
+            entry.assign(1, static_cast<char>(n->level));
+            skiplist_codec<K>::encode(n->key, entry);
+            skiplist_codec<V>::encode(n->value, entry);
+            writer.put(entry.data(), entry.size());
+        }
+    }
+    
+    // La lista debe estar vacia; data ya fue validado con readHeader.
+    void loadBody(const char* data, const skiplist_detail::FileHeader& header, true_type) {
+        skiplist_detail::RawLayout layout(header.count, sizeof(K), sizeof(V));
+        const K* keys = reinterpret_cast<const K*>(data + layout.keys);
+        const V* values = reinterpret_cast<const V*>(data + layout.values);
+        const uint8_t* levels = reinterpret_cast<const uint8_t*>(data + layout.levels);
         
-        return current->forward[0];
+        NodeBase* tails[MAX_LEVEL + 1];
+        size_t ranks[MAX_LEVEL + 1];
+        beginAppend(tails, ranks);
+        Node* tail = nullptr;
+        for (size_t i = 0; i < header.count; i++) {
+            checkLoadOrder(tail, keys[i]);
+            tail = createNode(storedLevel(levels[i]), keys[i], values[i]);
+            appendNode(tail, tails, ranks);
+        }
+        endAppend(tails, ranks);
     }
     
-    void copyFrom(const SkipList& other) {
-        maxPossibleLevel_ = other.maxPossibleLevel_;
-        probability_ = other.probability_;
-        maxLevel_ = other.maxLevel_;
-        size_ = other.size_;
+    void loadBody(const char* data, const skiplist_detail::FileHeader& header, false_type) {
+        const char* p = data + skiplist_detail::FILE_HEADER_BYTES;
+        const char* end = p + header.payloadBytes;
         
-        header_ = new Node(K(), V(), maxPossibleLevel_);
+        NodeBase* tails[MAX_LEVEL + 1];
+        size_t ranks[MAX_LEVEL + 1];
+        beginAppend(tails, ranks);
+        Node* tail = nullptr;
+        for (uint64_t i = 0; i < header.count; i++) {
+            if (p == end) {
+                throw runtime_error("Archivo de SkipList truncado");
+            }
+            int level = storedLevel(static_cast<uint8_t>(*p++));
+            K key = skiplist_codec<K>::decode(p, end);
+            V value = skiplist_codec<V>::decode(p, end);
+            checkLoadOrder(tail, key);
+            tail = createNode(level, std::move(key), std::move(value));
+            appendNode(tail, tails, ranks);
+        }
+        endAppend(tails, ranks);
+    }
+    
+    typedef integral_constant<bool, is_trivially_copyable<K>::value &&
+                                    is_trivially_copyable<V>::value> RawFormat;
+    
+    static const uint32_t FILE_FORMAT = RawFormat::value ? skiplist_detail::FORMAT_RAW
+                                                         : skiplist_detail::FORMAT_CODEC;
+    static const size_t FILE_KEY_SIZE = RawFormat::value ? sizeof(K) : 0;
+    static const size_t FILE_VALUE_SIZE = RawFormat::value ? sizeof(V) : 0;
+    
+    // Mueve el dedo (update/ranks, predecesores de una clave anterior q) a los
+    // predecesores de key. Sube desde el nivel 0 hasta un nivel L cuyo
+    // predecesor queda antes de key y cuyo sucesor no, y desciende desde ahi:
+    // los niveles por encima de L siguen siendo validos, asi que el costo es
+    // O(log d) en la distancia d entre q y key, en cualquier direccion.
+    template<typename Key>
+    Node* advanceFinger(const Key& key, NodeBase** update, size_t* ranks) const {
+        int top = 0;
+        // key anterior a q: subir hasta un predecesor que quede antes de key
+        while (update[top] != header_ && !comp_(static_cast<Node*>(update[top])->key, key)) {
+            if (top == maxLevel_) {
+                return findNode(key, update, ranks);
+            }
+            top++;
+        }
+        bool backward = top > 0;
+        // key posterior a q: subir mientras el enlace del dedo quede antes de key
+        while (!backward && top < maxLevel_) {
+            Node* candidate = next(update[top], top);
+            if (candidate == nullptr || !comp_(candidate->key, key)) break;
+            top++;
+        }
         
-        if (other.size_ == 0) return;
+        NodeBase* current = update[top];
+        size_t rank = ranks[top];
+        for (int i = top; i >= 0; i--) {
+            // Hacia adelante, el dedo de este nivel puede estar mas cerca
+            if (!backward && ranks[i] > rank) {
+                current = update[i];
+                rank = ranks[i];
+            }
+            Node* candidate;
+            while ((candidate = next(current, i)) != nullptr && comp_(candidate->key, key)) {
+                rank += spans(current)[i];
+                current = candidate;
+            }
+            update[i] = current;
+            ranks[i] = rank;
+        }
+        return next(current, 0);
+    }
+    
+    // Busqueda hacia adelante desde start (start->key < key) sin predecesores:
+    // sube por la torre de los nodos que recorre y luego desciende. O(log d).
+    template<typename Key>
+    Node* findFrom(Node* start, const Key& key) const {
+        NodeBase* current = start;
+        int i = 0;
+        while (true) {
+            while (i < current->level) {
+                Node* candidate = next(current, i + 1);
+                if (candidate == nullptr || !comp_(candidate->key, key)) break;
+                i++;
+            }
+            Node* candidate = next(current, i);
+            if (candidate == nullptr || !comp_(candidate->key, key)) break;
+            current = candidate;
+        }
+        for (; i >= 0; i--) {
+            Node* candidate;
+            while ((candidate = next(current, i)) != nullptr && comp_(candidate->key, key)) {
+                current = candidate;
+            }
+        }
+        return next(current, 0);
+    }
+    
+    // Busquedas simultaneas por grupo: cada descenso avanza un paso por ronda
+    // y deja pedido (prefetch) el nodo que leera en la siguiente, asi los
+    // fallos de cache de LOOKUP_GROUP busquedas se solapan en vez de
+    // encadenarse. Si la entrada esta ordenada y es densa (los rangos de la
+    // primera y la ultima clave dan en promedio una clave cada FINGER_GAP
+    // elementos o menos) se usa un dedo en su lugar, que reutiliza el camino
+    // de la clave anterior; con claves dispersas el dedo encadenaria los
+    // fallos. emit recibe el nodo de cada clave (o nullptr) en el orden de la
+    // entrada.
+    static const size_t LOOKUP_GROUP = 8;
+    static const size_t FINGER_GAP = 16;
+    
+    template<typename FwdIt, typename Emit>
+    void lookupBatch(FwdIt first, FwdIt last, Emit emit) const {
+        if (first == last) {
+            return;
+        }
+        size_t total = 1;
+        bool sorted = true;
+        FwdIt back = first;
+        for (FwdIt it = first; ++it != last; total++) {
+            if (comp_(*it, *back)) sorted = false;
+            back = it;
+        }
         
-        vector<Node*> update(maxPossibleLevel_ + 1, header_);
-        Node* otherCurrent = other.header_->forward[0];
+        NodeBase* update[MAX_LEVEL + 1];
+        size_t ranks[MAX_LEVEL + 1];
+        if (sorted && total > 1) {
+            NodeBase* backUpdate[MAX_LEVEL + 1];
+            size_t backRanks[MAX_LEVEL + 1];
+            findNode(*first, update, ranks);
+            findNode(*back, backUpdate, backRanks);
+            sorted = backRanks[0] - ranks[0] <= total * FINGER_GAP;
+        }
+        if (sorted && total > 1) {
+            for (; first != last; ++first) {
+                Node* current = advanceFinger(*first, update, ranks);
+                emit(current != nullptr && !comp_(*first, current->key) ? current : nullptr);
+            }
+            return;
+        }
         
-        while (otherCurrent != nullptr) {
-            int level = static_cast<int>(otherCurrent->forward.size()) - 1;
-            Node* newNode = new Node(otherCurrent->key, otherCurrent->value, level);
+        while (first != last) {
+            FwdIt keys[LOOKUP_GROUP];
+            NodeBase* current[LOOKUP_GROUP];
+            int level[LOOKUP_GROUP];
+            size_t count = 0;
+            for (; count < LOOKUP_GROUP && first != last; ++first, ++count) {
+                keys[count] = first;
+                current[count] = header_;
+                level[count] = maxLevel_;
+            }
+            SKIPLIST_PREFETCH(next(header_, maxLevel_));
             
-            for (int i = 0; i <= level; i++) {
-                update[i]->forward[i] = newNode;
-                update[i] = newNode;
+            size_t active = count;
+            while (active > 0) {
+                for (size_t s = 0; s < count; s++) {
+                    if (level[s] < 0) continue;
+                    Node* candidate = next(current[s], level[s]);
+                    if (candidate != nullptr && comp_(candidate->key, *keys[s])) {
+                        current[s] = candidate;
+                    } else if (--level[s] < 0) {
+                        active--;
+                        continue;
+                    }
+                    SKIPLIST_PREFETCH(next(current[s], level[s]));
+                }
             }
             
-            otherCurrent = otherCurrent->forward[0];
+            for (size_t s = 0; s < count; s++) {
+                Node* found = next(current[s], 0);
+                emit(found != nullptr && !comp_(*keys[s], found->key) ? found : nullptr);
+            }
+        }
+    }
+    
+    Node* selectNode(size_t index) const {
+        if (index >= size_) {
+            return nullptr;
+        }
+        size_t target = index + 1;
+        size_t traversed = 0;
+        NodeBase* current = header_;
+        for (int i = maxLevel_; i >= 0; i--) {
+            while (next(current, i) != nullptr && traversed + spans(current)[i] <= target) {
+                traversed += spans(current)[i];
+                current = next(current, i);
+            }
+            if (traversed == target) {
+                return static_cast<Node*>(current);
+            }
         }
+        return nullptr;
+    }
+    
+    // Enlaza node detras de update[i] en sus niveles y ajusta los spans.
+    // ranks[i] es el rango de update[i]; update y ranks deben cubrir hasta
+    // maxLevel_, que ya debe ser >= node->level.
+    void linkNode(Node* node, NodeBase** update, const size_t* ranks) {
+        size_t position = ranks[0] + 1;
+        for (int i = 0; i <= node->level; i++) {
+            tower(node)[i] = next(update[i], i);
+            tower(update[i])[i] = node;
+            spans(node)[i] = ranks[i] + spans(update[i])[i] + 1 - position;
+            spans(update[i])[i] = position - ranks[i];
+        }
+        for (int i = node->level + 1; i <= maxLevel_; i++) {
+            spans(update[i])[i]++;
+        }
+        node->backward = asNode(update[0]);
+        backOwner(next(node, 0))->backward = node;
+        size_++;
+        fingerValid_ = false;
+    }
+    
+    // Sube maxLevel_ si node es mas alto (completando update/ranks con el
+    // header) y lo enlaza
+    void linkNew(Node* node, NodeBase** update, size_t* ranks) {
+        if (node->level > maxLevel_) {
+            for (int i = maxLevel_ + 1; i <= node->level; i++) {
+                update[i] = header_;
+                ranks[i] = 0;
+                spans(header_)[i] = size_ + 1;
+            }
+            maxLevel_ = node->level;
+        }
+        linkNode(node, update, ranks);
+    }
+    
+    // Unico camino de insercion: si la clave existe devuelve su nodo sin
+    // tocarlo (ni consumir key y args); si no, construye el nodo con
+    // std::forward de key y args y lo enlaza.
+    template<typename KK, typename... Args>
+    pair<Node*, bool> insertUnique(KK&& key, Args&&... args) {
+        skiplist_detail::LatencyProbe latency(counters_, skiplist_detail::STAT_INSERT);
+        NodeBase* update[MAX_LEVEL + 1];
+        size_t ranks[MAX_LEVEL + 1];
+        Node* current = findNode(key, update, ranks);
+        
+        if (current != nullptr && !comp_(key, current->key)) {
+            return make_pair(current, false);
+        }
+        
+        Node* newNode = createNode(randomLevel(), std::forward<KK>(key), std::forward<Args>(args)...);
+        linkNew(newNode, update, ranks);
+        return make_pair(newNode, true);
+    }
+    
+    // Desenlaza current (update deben ser sus predecesores) sin destruirlo
+    void unlinkNode(Node* current, NodeBase** update) {
+        for (int i = 0; i <= current->level; i++) {
+            tower(update[i])[i] = next(current, i);
+            spans(update[i])[i] += spans(current)[i] - 1;
+        }
+        for (int i = current->level + 1; i <= maxLevel_; i++) {
+            spans(update[i])[i]--;
+        }
+        backOwner(next(current, 0))->backward = current->backward;
+        
+        while (maxLevel_ > 0 && next(header_, maxLevel_) == nullptr) {
+            maxLevel_--;
+        }
+        
+        size_--;
+        fingerValid_ = false;
+    }
+    
+    // Desenlaza el primer nodo: todos sus predecesores son el header
+    void unlinkFront(Node* first) {
+        NodeBase* update[MAX_LEVEL + 1];
+        for (int i = 0; i <= maxLevel_; i++) {
+            update[i] = header_;
+        }
+        unlinkNode(first, update);
     }
     
 public:
-    class Iterator {
+    // Iterador bidireccional: operator-- sigue los enlaces backward y desde
+    // end() va al ultimo elemento, por eso guarda el header de la lista.
+    // ConstIterator solo da acceso de lectura al valor.
+    template<bool IsConst>
+    class BasicIterator {
     private:
+        friend class SkipList;
+        friend class BasicIterator<!IsConst>;
+        
+        typedef typename conditional<IsConst, const V, V>::type Value;
+        
         Node* node_;
+        NodeBase* header_;
         
     public:
-        using iterator_category = forward_iterator_tag;
-        using value_type = pair<K&, V&>;
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = pair<typename conditional<IsConst, const K, K>::type&, Value&>;
         using difference_type = ptrdiff_t;
         using pointer = value_type*;
         using reference = value_type;
         
-        explicit Iterator(Node* node) : node_(node) {}
+        BasicIterator() : node_(nullptr), header_(nullptr) {}
+        
+        BasicIterator(Node* node, NodeBase* header) : node_(node), header_(header) {}
+        
+        // Iterator se convierte en ConstIterator
+        template<bool C = IsConst, typename = typename enable_if<C>::type>
+        BasicIterator(const BasicIterator<false>& other) : node_(other.node_), header_(other.header_) {}
         
         reference operator*() const {
             return {node_->key, node_->value};
         }
         
-        Iterator& operator++() {
-            if (node_) node_ = node_->forward[0];
+        BasicIterator& operator++() {
+            if (node_) node_ = next(node_, 0);
             return *this;
         }
         
-        Iterator operator++(int) {
-            Iterator tmp = *this;
+        BasicIterator operator++(int) {
+            BasicIterator tmp = *this;
             ++(*this);
             return tmp;
         }
         
-        bool operator==(const Iterator& other) const {
+        BasicIterator& operator--() {
+            node_ = node_ != nullptr ? node_->backward : header_->backward;
+            return *this;
+        }
+        
+        BasicIterator operator--(int) {
+            BasicIterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+        
+        template<bool C>
+        bool operator==(const BasicIterator<C>& other) const {
             return node_ == other.node_;
         }
         
-        bool operator!=(const Iterator& other) const {
+        template<bool C>
+        bool operator!=(const BasicIterator<C>& other) const {
             return node_ != other.node_;
         }
         
         const K& key() const { return node_->key; }
-        V& value() { return node_->value; }
-        const V& value() const { return node_->value; }
+        Value& value() const { return node_->value; }
+    };
+    
+    typedef BasicIterator<false> Iterator;
+    typedef BasicIterator<true> ConstIterator;
+    typedef std::reverse_iterator<Iterator> ReverseIterator;
+    typedef std::reverse_iterator<ConstIterator> ConstReverseIterator;
+    
+    typedef Iterator iterator;
+    typedef ConstIterator const_iterator;
+    typedef ReverseIterator reverse_iterator;
+    typedef ConstReverseIterator const_reverse_iterator;
+    
+    // Nodo fuera de la lista, devuelto por extract(). Es dueño del nodo (y de
+    // una copia del allocator con que se reservo) hasta reinsertarlo con
+    // insert(NodeHandle&&) en esta u otra lista del mismo tipo; si no, lo
+    // destruye.
+    class NodeHandle {
+    private:
+        friend class SkipList;
+        
+        Node* node_;
+        UnitAlloc alloc_;
+        
+        NodeHandle(Node* node, const UnitAlloc& alloc) : node_(node), alloc_(alloc) {}
+        
+        void reset() {
+            if (node_ != nullptr) {
+                int level = node_->level;
+                node_->~Node();
+                UnitTraits::deallocate(alloc_, reinterpret_cast<NodeUnit*>(node_), nodeUnits(level));
+                node_ = nullptr;
+            }
+        }
+        
+    public:
+        NodeHandle() : node_(nullptr), alloc_() {}
+        
+        NodeHandle(NodeHandle&& other) noexcept : node_(other.node_), alloc_(other.alloc_) {
+            other.node_ = nullptr;
+        }
+        
+        NodeHandle& operator=(NodeHandle&& other) noexcept {
+            if (this != &other) {
+                reset();
+                node_ = other.node_;
+                alloc_ = other.alloc_;
+                other.node_ = nullptr;
+            }
+            return *this;
+        }
+        
+        NodeHandle(const NodeHandle&) = delete;
+        NodeHandle& operator=(const NodeHandle&) = delete;
+        
+        ~NodeHandle() {
+            reset();
+        }
+        
+        bool empty() const noexcept {
+            return node_ == nullptr;
+        }
+        
+        explicit operator bool() const noexcept {
+            return node_ != nullptr;
+        }
+        
+        // La clave se puede modificar antes de reinsertar
+        K& key() const { return node_->key; }
+        V& mapped() const { return node_->value; }
     };
     
-    explicit SkipList(int maxLevel = 16, float probability = 0.5f)
-        : maxPossibleLevel_(maxLevel)
+    typedef NodeHandle node_type;
+    
+    explicit SkipList(int maxLevel = 16, float probability = 0.5f,
+                      const Compare& comp = Compare(), const Alloc& alloc = Alloc())
+        : alloc_(alloc)
+        , comp_(comp)
+        , maxPossibleLevel_(maxLevel == AUTO_LEVEL ? MAX_LEVEL : maxLevel)
         , probability_(probability)
         , maxLevel_(0)
         , size_(0)
-        , rng_(random_device{}())
-        , dist_(0.0f, 1.0f) {
+        , levels_(probability, random_device{}())
+        , autoLevel_(maxLevel == AUTO_LEVEL)
+        , levelCap_(0)
+        , capLow_(0)
+        , capHigh_(0)
+        , fingerValid_(false) {
         
+        if ((maxLevel < 0 && maxLevel != AUTO_LEVEL) || maxLevel > MAX_LEVEL) {
+            throw invalid_argument("maxLevel debe estar entre 0 y 32");
+        }
         if (probability <= 0.0f || probability >= 1.0f) {
             throw invalid_argument("probability debe estar entre 0 y 1 (exclusivo)");
         }
         
-        header_ = new Node(K(), V(), maxPossibleLevel_);
+        header_ = createHeader(maxPossibleLevel_);
     }
     
     ~SkipList() {
-        clear();
-        delete header_;
+        destroyAll();
     }
     
     SkipList(const SkipList& other) 
-        : rng_(random_device{}())
-        , dist_(0.0f, 1.0f) {
+        : alloc_(UnitTraits::select_on_container_copy_construction(other.alloc_))
+        , comp_(other.comp_)
+        , levels_(other.levels_)
+        , autoLevel_(other.autoLevel_)
+        , levelCap_(0)
+        , capLow_(0)
+        , capHigh_(0)
+        , fingerValid_(false) {
         copyFrom(other);
     }
     
+    // Copia con varios hilos (threads = 0: hardware_concurrency()). Con un
+    // allocator con estado, o listas chicas, copia como el constructor normal.
+    SkipList(const SkipList& other, unsigned threads)
+        : alloc_(UnitTraits::select_on_container_copy_construction(other.alloc_))
+        , comp_(other.comp_)
+        , levels_(other.levels_)
+        , autoLevel_(other.autoLevel_)
+        , levelCap_(0)
+        , capLow_(0)
+        , capHigh_(0)
+        , fingerValid_(false) {
+        parallelCopyFrom(other, threads);
+    }
+    
     SkipList& operator=(const SkipList& other) {
         if (this != &other) {
-            // Limpiar datos actuales
-            clear();
-            delete header_;
-            
-            copyFrom(other);
+            // Copiar primero: si la copia lanza, la lista actual queda intacta
+            SkipList tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+    
+    // El allocator se copia (no se mueve): la lista origen lo sigue usando
+    // para su nuevo header.
+    SkipList(SkipList&& other) noexcept
+        : alloc_(other.alloc_)
+        , comp_(other.comp_)
+        , header_(other.header_)
+        , maxPossibleLevel_(other.maxPossibleLevel_)
+        , probability_(other.probability_)
+        , maxLevel_(other.maxLevel_)
+        , size_(other.size_)
+        , levels_(other.levels_)
+        , autoLevel_(other.autoLevel_)
+        , levelCap_(0)
+        , capLow_(0)
+        , capHigh_(0)
+        , fingerValid_(false) {
+        
+        other.header_ = createHeader(other.maxPossibleLevel_);
+        other.maxLevel_ = 0;
+        other.size_ = 0;
+        other.fingerValid_ = false;
+    }
+    
+    SkipList& operator=(SkipList&& other) noexcept {
+        if (this != &other) {
+            SkipList tmp(move(other));
+            swap(tmp);
         }
         return *this;
     }
     
-    SkipList(SkipList&& other) noexcept
-        : header_(other.header_)
-        , maxPossibleLevel_(other.maxPossibleLevel_)
-        , probability_(other.probability_)
-        , maxLevel_(other.maxLevel_)
-        , size_(other.size_)
-        , rng_(move(other.rng_))
-        , dist_(move(other.dist_)) {
-        
-        other.header_ = new Node(K(), V(), other.maxPossibleLevel_);
-        other.maxLevel_ = 0;
-        other.size_ = 0;
+    bool insert(const K& key, const V& value) {
+        return insert_or_assign(key, value).second;
+    }
+    
+    // Mueve la clave (si es nueva) y el valor en lugar de copiarlos
+    bool insert(K&& key, V&& value) {
+        return insert_or_assign(std::move(key), std::move(value)).second;
+    }
+    
+    bool insert(const K& key, V&& value) {
+        return insert_or_assign(key, std::move(value)).second;
+    }
+    
+    // Como insert() pero construyendo V desde obj; si la clave existe le
+    // asigna obj. Devuelve el elemento y si la clave era nueva.
+    template<typename M>
+    pair<Iterator, bool> insert_or_assign(const K& key, M&& obj) {
+        pair<Node*, bool> result = insertUnique(key, std::forward<M>(obj));
+        if (!result.second) {
+            result.first->value = std::forward<M>(obj);
+        }
+        return make_pair(Iterator(result.first, header_), result.second);
+    }
+    
+    template<typename M>
+    pair<Iterator, bool> insert_or_assign(K&& key, M&& obj) {
+        pair<Node*, bool> result = insertUnique(std::move(key), std::forward<M>(obj));
+        if (!result.second) {
+            result.first->value = std::forward<M>(obj);
+        }
+        return make_pair(Iterator(result.first, header_), result.second);
+    }
+    
+    // Construye el valor in-place solo si la clave es nueva; si ya existe no
+    // toca el valor ni consume key ni args.
+    template<typename... Args>
+    pair<Iterator, bool> try_emplace(const K& key, Args&&... args) {
+        pair<Node*, bool> result = insertUnique(key, std::forward<Args>(args)...);
+        return make_pair(Iterator(result.first, header_), result.second);
+    }
+    
+    template<typename... Args>
+    pair<Iterator, bool> try_emplace(K&& key, Args&&... args) {
+        pair<Node*, bool> result = insertUnique(std::move(key), std::forward<Args>(args)...);
+        return make_pair(Iterator(result.first, header_), result.second);
+    }
+    
+    // Construye el valor in-place si la clave es nueva; si ya existe, lo
+    // reemplaza igual que insert().
+    template<typename... Args>
+    bool emplace(const K& key, Args&&... args) {
+        pair<Node*, bool> result = insertUnique(key, std::forward<Args>(args)...);
+        if (!result.second) {
+            result.first->value = V(std::forward<Args>(args)...);
+        }
+        return result.second;
+    }
+    
+    bool search(const K& key, V& value) const {
+        return searchImpl(key, value);
+    }
+    
+    template<typename Key, typename C = Compare, typename = typename C::is_transparent>
+    bool search(const Key& key, V& value) const {
+        return searchImpl(key, value);
+    }
+    
+    bool contains(const K& key) const {
+        return findEqual(key) != nullptr;
+    }
+    
+    template<typename Key, typename C = Compare, typename = typename C::is_transparent>
+    bool contains(const Key& key) const {
+        return findEqual(key) != nullptr;
+    }
+    
+    Iterator find(const K& key) {
+        return Iterator(findEqual(key), header_);
+    }
+    
+    template<typename Key, typename C = Compare, typename = typename C::is_transparent>
+    Iterator find(const Key& key) {
+        return Iterator(findEqual(key), header_);
+    }
+    
+    ConstIterator find(const K& key) const {
+        return ConstIterator(findEqual(key), header_);
+    }
+    
+    template<typename Key, typename C = Compare, typename = typename C::is_transparent>
+    ConstIterator find(const Key& key) const {
+        return ConstIterator(findEqual(key), header_);
     }
     
-    SkipList& operator=(SkipList&& other) noexcept {
-        if (this != &other) {
-            clear();
-            delete header_;
-            
-            header_ = other.header_;
-            maxLevel_ = other.maxLevel_;
-            maxPossibleLevel_ = other.maxPossibleLevel_;
-            probability_ = other.probability_;
-            size_ = other.size_;
-            rng_ = move(other.rng_);
-            dist_ = move(other.dist_);
-            
-            other.header_ = new Node(K(), V(), other.maxPossibleLevel_);
-            other.maxLevel_ = 0;
-            other.size_ = 0;
+    // Busca todas las claves de [first, last) y escribe en out un Iterator
+    // por clave (end() si no esta), en el mismo orden. Solapa los fallos de
+    // cache de varias busquedas y, si las claves vienen ordenadas, reutiliza
+    // el camino entre claves consecutivas.
+    template<typename FwdIt, typename OutputIt>
+    OutputIt multi_find(FwdIt first, FwdIt last, OutputIt out) {
+        lookupBatch(first, last, [this, &out](Node* node) { *out++ = Iterator(node, header_); });
+        return out;
+    }
+    
+    // Como multi_find pero escribe un bool por clave; devuelve cuantas estan
+    template<typename FwdIt, typename OutputIt>
+    size_t contains_batch(FwdIt first, FwdIt last, OutputIt out) const {
+        size_t found = 0;
+        lookupBatch(first, last, [&out, &found](Node* node) {
+            *out++ = node != nullptr;
+            found += node != nullptr;
+        });
+        return found;
+    }
+    
+    // Busca a partir de hint: O(log d) en la distancia d desde hint si la
+    // clave esta por delante; si no, busca desde el header.
+    Iterator find(Iterator hint, const K& key) {
+        if (hint.node_ == nullptr || comp_(key, hint.node_->key)) {
+            return find(key);
         }
-        return *this;
+        if (!comp_(hint.node_->key, key)) {
+            return hint;
+        }
+        Node* current = findFrom(hint.node_, key);
+        if (current != nullptr && !comp_(key, current->key)) {
+            return Iterator(current, header_);
+        }
+        return end();
     }
     
-    bool insert(const K& key, const V& value) {
-        vector<Node*> update;
-        update.reserve(maxPossibleLevel_ + 1);
-        
-        Node* current = findNode(key, &update);
+    // Insercion con localidad. Si hint apunta a la clave solo se actualiza el
+    // valor; si no, la posicion se busca desde el dedo de la insercion con
+    // pista anterior, en O(log d) para una clave a distancia d (flujos casi
+    // ordenados). Devuelve un iterador al elemento.
+    Iterator insert(Iterator hint, const K& key, const V& value) {
+        skiplist_detail::LatencyProbe latency(counters_, skiplist_detail::STAT_INSERT);
+        if (hint.node_ != nullptr && !comp_(hint.node_->key, key) && !comp_(key, hint.node_->key)) {
+            hint.node_->value = value;
+            return hint;
+        }
         
-        if (current != nullptr && current->key == key) {
+        Node* current;
+        if (fingerValid_) {
+            current = advanceFinger(key, finger_, fingerRanks_);
+        } else {
+            current = findNode(key, finger_, fingerRanks_);
+            fingerValid_ = true;
+        }
+        if (current != nullptr && !comp_(key, current->key)) {
             current->value = value;
-            return false;
+            return Iterator(current, header_);
         }
         
         int newLevel = randomLevel();
-        
+        Node* newNode = createNode(newLevel, key, value);
         if (newLevel > maxLevel_) {
             for (int i = maxLevel_ + 1; i <= newLevel; i++) {
-                update[i] = header_;
+                finger_[i] = header_;
+                fingerRanks_[i] = 0;
+                spans(header_)[i] = size_ + 1;
             }
             maxLevel_ = newLevel;
         }
+        linkNode(newNode, finger_, fingerRanks_);
+        // Los predecesores de key siguen siendo validos con el nodo enlazado
+        fingerValid_ = true;
+        return Iterator(newNode, header_);
+    }
+    
+    V& at(const K& key) {
+        return atImpl(key);
+    }
+    
+    const V& at(const K& key) const {
+        return atImpl(key);
+    }
+    
+    template<typename Key, typename C = Compare, typename = typename C::is_transparent>
+    V& at(const Key& key) {
+        return atImpl(key);
+    }
+    
+    template<typename Key, typename C = Compare, typename = typename C::is_transparent>
+    const V& at(const Key& key) const {
+        return atImpl(key);
+    }
+    
+    V& operator[](const K& key) {
+        return insertUnique(key).first->value;
+    }
+    
+    V& operator[](K&& key) {
+        return insertUnique(std::move(key)).first->value;
+    }
+    
+    bool remove(const K& key) {
+        skiplist_detail::LatencyProbe latency(counters_, skiplist_detail::STAT_REMOVE);
+        NodeBase* update[MAX_LEVEL + 1];
+        Node* current = findNode(key, update);
         
-        Node* newNode = new Node(key, value, newLevel);
-        
-        for (int i = 0; i <= newLevel; i++) {
-            newNode->forward[i] = update[i]->forward[i];
-            update[i]->forward[i] = newNode;
+        if (current == nullptr || comp_(key, current->key)) {
+            return false;
         }
         
-        size_++;
+        unlinkNode(current, update);
+        destroyNode(current);
         return true;
     }
     
-    
-    template<typename... Args>
-    bool emplace(const K& key, Args&&... args) {
-        return insert(key, V(forward<Args>(args)...));
+    // Saca el nodo de key sin destruirlo ni copiar nada; vacio si no esta
+    NodeHandle extract(const K& key) {
+        skiplist_detail::LatencyProbe latency(counters_, skiplist_detail::STAT_REMOVE);
+        NodeBase* update[MAX_LEVEL + 1];
+        Node* current = findNode(key, update);
+        
+        if (current == nullptr || comp_(key, current->key)) {
+            return NodeHandle(nullptr, alloc_);
+        }
+        unlinkNode(current, update);
+        return NodeHandle(current, alloc_);
     }
     
-    bool search(const K& key, V& value) const {
-        Node* node = findNode(key);
-        
-        if (node != nullptr && node->key == key) {
-            value = node->value;
-            return true;
+    // Reinserta un nodo de extract(). Si la clave ya existe no inserta y
+    // handle conserva el nodo. El nodo se enlaza tal cual (sin reservar ni
+    // mover K y V) si los allocators son iguales y su torre cabe en esta
+    // lista; si no, K y V se mueven a un nodo nuevo.
+    pair<Iterator, bool> insert(NodeHandle&& handle) {
+        if (handle.empty()) {
+            return make_pair(end(), false);
+        }
+        skiplist_detail::LatencyProbe latency(counters_, skiplist_detail::STAT_INSERT);
+        NodeBase* update[MAX_LEVEL + 1];
+        size_t ranks[MAX_LEVEL + 1];
+        Node* current = findNode(handle.key(), update, ranks);
+        if (current != nullptr && !comp_(handle.key(), current->key)) {
+            return make_pair(Iterator(current, header_), false);
         }
         
-        return false;
+        Node* node = handle.node_;
+        if (alloc_ == handle.alloc_ && node->level <= maxPossibleLevel_) {
+            handle.node_ = nullptr;
+        } else {
+            node = createNode(randomLevel(), std::move(node->key), std::move(node->value));
+            handle.reset();
+        }
+        linkNew(node, update, ranks);
+        return make_pair(Iterator(node, header_), true);
     }
     
-    bool contains(const K& key) const {
-        Node* node = findNode(key);
-        return node != nullptr && node->key == key;
+    // Quita el minimo sin buscarlo: sus predecesores son siempre el header,
+    // asi que solo se tocan la torre del nodo y los spans del header.
+    bool pop_front() {
+        skiplist_detail::LatencyProbe latency(counters_, skiplist_detail::STAT_REMOVE);
+        Node* first = next(header_, 0);
+        if (first == nullptr) {
+            return false;
+        }
+        unlinkFront(first);
+        destroyNode(first);
+        return true;
     }
     
-    Iterator find(const K& key) {
-        Node* node = findNode(key);
-        if (node != nullptr && node->key == key) {
-            return Iterator(node);
+    // Igual, moviendo la clave y el valor del minimo a key y value
+    bool pop_front(K& key, V& value) {
+        skiplist_detail::LatencyProbe latency(counters_, skiplist_detail::STAT_REMOVE);
+        Node* first = next(header_, 0);
+        if (first == nullptr) {
+            return false;
         }
-        return end();
+        key = std::move(first->key);
+        value = std::move(first->value);
+        unlinkFront(first);
+        destroyNode(first);
+        return true;
     }
     
-    V& at(const K& key) {
-        Node* node = findNode(key);
+    // Quita todas las claves <= key (por ejemplo, los timers vencidos) y
+    // escribe en out un pair<K, V> movido por cada una, en orden. El prefijo
+    // se desprende con un solo descenso; devuelve cuantas se quitaron.
+    template<typename OutputIt>
+    size_t pop_until(const K& key, OutputIt out) {
+        skiplist_detail::LatencyProbe latency(counters_, skiplist_detail::STAT_REMOVE);
+        NodeBase* update[MAX_LEVEL + 1];
+        size_t ranks[MAX_LEVEL + 1] = {};
+        NodeBase* current = header_;
+        size_t rank = 0;
+        for (int i = maxLevel_; i >= 0; i--) {
+            Node* candidate;
+            while ((candidate = next(current, i)) != nullptr && !comp_(key, candidate->key)) {
+                rank += spans(current)[i];
+                current = candidate;
+            }
+            update[i] = current;
+            ranks[i] = rank;
+        }
+        size_t count = ranks[0];
+        if (count == 0) {
+            return 0;
+        }
         
-        if (node != nullptr && node->key == key) {
-            return node->value;
+        Node* first = next(header_, 0);
+        for (int i = 0; i <= maxLevel_; i++) {
+            spans(header_)[i] = ranks[i] + spans(update[i])[i] - count;
+            tower(header_)[i] = next(update[i], i);
+        }
+        backOwner(next(header_, 0))->backward = nullptr;
+        size_ -= count;
+        while (maxLevel_ > 0 && next(header_, maxLevel_) == nullptr) {
+            maxLevel_--;
         }
+        fingerValid_ = false;
         
-        throw out_of_range("Clave no encontrada en SkipList");
+        for (size_t i = 0; i < count; i++) {
+            Node* following = next(first, 0);
+            *out++ = make_pair(std::move(first->key), std::move(first->value));
+            destroyNode(first);
+            first = following;
+        }
+        return count;
     }
     
-    const V& at(const K& key) const {
-        Node* node = findNode(key);
+    // Parte la lista en key: esta conserva las claves < key y se devuelven
+    // las >= key. Solo se recablean las torres del borde: O(log n), sin
+    // reservar ni copiar nodos. La parte devuelta arranca con una copia del
+    // generador de niveles, asi que una lista con seed() sigue siendo
+    // reproducible.
+    SkipList split(const K& key) {
+        SkipList result(levelParam(), probability_, comp_, Alloc(alloc_));
+        result.levels_ = levels_;
+        NodeBase* update[MAX_LEVEL + 1];
+        size_t ranks[MAX_LEVEL + 1] = {};
+        Node* first = findNode(key, update, ranks);
+        if (first == nullptr) {
+            return result;
+        }
         
-        if (node != nullptr && node->key == key) {
-            return node->value;
+        size_t kept = ranks[0];
+        for (int i = 0; i <= maxLevel_; i++) {
+            tower(result.header_)[i] = next(update[i], i);
+            spans(result.header_)[i] = ranks[i] + spans(update[i])[i] - kept;
+            tower(update[i])[i] = nullptr;
+            spans(update[i])[i] = kept + 1 - ranks[i];
         }
+        result.header_->backward = header_->backward;
+        header_->backward = first->backward;
+        first->backward = nullptr;
+        result.size_ = size_ - kept;
+        result.maxLevel_ = maxLevel_;
+        size_ = kept;
         
-        throw out_of_range("Clave no encontrada en SkipList");
+        while (maxLevel_ > 0 && next(header_, maxLevel_) == nullptr) {
+            maxLevel_--;
+        }
+        while (result.maxLevel_ > 0 && next(result.header_, result.maxLevel_) == nullptr) {
+            result.maxLevel_--;
+        }
+        fingerValid_ = false;
+        return result;
     }
     
-    V& operator[](const K& key) {
-        vector<Node*> update;
-        update.reserve(maxPossibleLevel_ + 1);
-        
-        Node* current = findNode(key, &update);
+    // Concatena other, cuyas claves deben ser todas mayores que las de esta
+    // lista; other queda vacia. O(log n + log m): solo se enlazan los
+    // ultimos nodos de cada nivel con los primeros de other.
+    void join(SkipList& other) {
+        if (this == &other || other.size_ == 0) return;
+        checkSplice(other);
+        if (size_ > 0 && !comp_(header_->backward->key, next(other.header_, 0)->key)) {
+            throw invalid_argument("join requiere que las claves de other sean mayores");
+        }
         
-        if (current != nullptr && current->key == key) {
-            return current->value;
+        NodeBase* tails[MAX_LEVEL + 1];
+        size_t ranks[MAX_LEVEL + 1];
+        findTails(tails, ranks);
+        size_t total = size_ + other.size_;
+        int height = maxLevel_ > other.maxLevel_ ? maxLevel_ : other.maxLevel_;
+        for (int i = 0; i <= height; i++) {
+            Node* following = i <= other.maxLevel_ ? next(other.header_, i) : nullptr;
+            tower(tails[i])[i] = following;
+            spans(tails[i])[i] = following != nullptr ? size_ + spans(other.header_)[i] - ranks[i]
+                                                      : total + 1 - ranks[i];
         }
+        next(other.header_, 0)->backward = asNode(tails[0]);
+        header_->backward = other.header_->backward;
+        size_ = total;
+        maxLevel_ = height;
+        fingerValid_ = false;
+        other.detachAll();
+    }
+    
+    // Como std::map::merge: pasa a esta lista los nodos de other cuyas
+    // claves no estan; los repetidos quedan en other. Un barrido lineal que
+    // reconstruye las torres de ambas sin reservar ni copiar nodos.
+    void merge(SkipList& other) {
+        if (this == &other || other.size_ == 0) return;
+        checkSplice(other);
         
-        int newLevel = randomLevel();
+        Node* a = next(header_, 0);
+        Node* b = next(other.header_, 0);
+        detachAll();
+        other.detachAll();
+        NodeBase* tails[MAX_LEVEL + 1];
+        size_t ranks[MAX_LEVEL + 1];
+        NodeBase* otherTails[MAX_LEVEL + 1];
+        size_t otherRanks[MAX_LEVEL + 1];
+        beginAppend(tails, ranks);
+        other.beginAppend(otherTails, otherRanks);
         
-        if (newLevel > maxLevel_) {
-            for (int i = maxLevel_ + 1; i <= newLevel; i++) {
-                update[i] = header_;
+        while (a != nullptr || b != nullptr) {
+            if (b == nullptr || (a != nullptr && comp_(a->key, b->key))) {
+                Node* following = next(a, 0);
+                appendNode(a, tails, ranks);
+                a = following;
+            } else {
+                Node* following = next(b, 0);
+                if (a != nullptr && !comp_(b->key, a->key)) {
+                    other.appendNode(b, otherTails, otherRanks);
+                } else {
+                    appendNode(b, tails, ranks);
+                }
+                b = following;
             }
-            maxLevel_ = newLevel;
         }
+        endAppend(tails, ranks);
+        other.endAppend(otherTails, otherRanks);
+    }
+    
+    // Union: como merge, pero en claves repetidas se conserva el valor de
+    // esta lista y el nodo de other se libera; other queda vacia.
+    void unite(SkipList& other) {
+        if (this == &other || other.size_ == 0) return;
+        checkSplice(other);
         
-        Node* newNode = new Node(key, V(), newLevel);
+        Node* a = next(header_, 0);
+        Node* b = next(other.header_, 0);
+        detachAll();
+        other.detachAll();
+        NodeBase* tails[MAX_LEVEL + 1];
+        size_t ranks[MAX_LEVEL + 1];
+        beginAppend(tails, ranks);
         
-        for (int i = 0; i <= newLevel; i++) {
-            newNode->forward[i] = update[i]->forward[i];
-            update[i]->forward[i] = newNode;
+        while (a != nullptr || b != nullptr) {
+            if (b == nullptr || (a != nullptr && comp_(a->key, b->key))) {
+                Node* following = next(a, 0);
+                appendNode(a, tails, ranks);
+                a = following;
+            } else {
+                Node* following = next(b, 0);
+                if (a != nullptr && !comp_(b->key, a->key)) {
+                    other.destroyNode(b);
+                } else {
+                    appendNode(b, tails, ranks);
+                }
+                b = following;
+            }
         }
-        
-        size_++;
-        return newNode->value;
+        endAppend(tails, ranks);
     }
     
-    bool remove(const K& key) {
-        vector<Node*> update;
-        update.reserve(maxPossibleLevel_ + 1);
-        
-        Node* current = findNode(key, &update);
-        
-        if (current == nullptr || current->key != key) {
-            return false;
+    // Interseccion: conserva solo las claves que tambien estan en other.
+    // O(n + m), sin reservar; other no cambia.
+    void intersect(const SkipList& other) {
+        if (this == &other) return;
+        retainIf(other, true);
+    }
+    
+    // Diferencia: elimina las claves que estan en other. O(n + m).
+    void subtract(const SkipList& other) {
+        if (this == &other) {
+            clear();
+            return;
         }
+        retainIf(other, false);
+    }
+    
+    bool erase(const K& key) {
+        return remove(key);
+    }
+    
+    // Elimina las claves en [lo, hi) en una sola pasada: una busqueda para los
+    // predecesores de lo y luego cada nodo del rango se desenlaza en todos sus
+    // niveles a la vez. O(log n + k). Devuelve cuantos elementos elimino.
+    size_t erase_range(const K& lo, const K& hi) {
+        NodeBase* update[MAX_LEVEL + 1];
+        size_t ranks[MAX_LEVEL + 1] = {};
+        Node* current = findNode(lo, update, ranks);
+        size_t removed = 0;
+        size_t rank = ranks[0] + 1;
         
-        for (int i = 0; i <= maxLevel_; i++) {
-            if (update[i]->forward[i] != current) {
-                break;
+        while (current != nullptr && comp_(current->key, hi)) {
+            Node* following = next(current, 0);
+            for (int i = 0; i <= current->level; i++) {
+                tower(update[i])[i] = next(current, i);
+                // Distancia al nuevo sucesor en rangos previos al borrado
+                spans(update[i])[i] = rank + spans(current)[i] - ranks[i];
             }
-            update[i]->forward[i] = current->forward[i];
+            destroyNode(current);
+            removed++;
+            rank++;
+            current = following;
         }
         
-        delete current;
+        for (int i = 0; i <= maxLevel_; i++) {
+            spans(update[i])[i] -= removed;
+        }
+        if (removed != 0) {
+            backOwner(current)->backward = asNode(update[0]);
+        }
         
-        while (maxLevel_ > 0 && header_->forward[maxLevel_] == nullptr) {
+        while (maxLevel_ > 0 && next(header_, maxLevel_) == nullptr) {
             maxLevel_--;
         }
         
-        size_--;
-        return true;
-    }
-    
-    bool erase(const K& key) {
-        return remove(key);
+        size_ -= removed;
+        if (removed != 0) {
+            fingerValid_ = false;
+        }
+        return removed;
     }
     
     void clear() {
-        freeList();
-        
-        for (int i = 0; i <= maxPossibleLevel_; i++) {
-            header_->forward[i] = nullptr;
-        }
+        destroyAll();
+        header_ = createHeader(maxPossibleLevel_);
         
         maxLevel_ = 0;
         size_ = 0;
+        fingerValid_ = false;
+    }
+    
+    Alloc get_allocator() const {
+        return Alloc(alloc_);
+    }
+    
+    Compare key_comp() const {
+        return comp_;
     }
     
     size_t size() const noexcept {
@@ -382,22 +2419,413 @@ public:
         return maxLevel_;
     }
     
+    // Reinicia el generador de niveles: misma semilla y mismas operaciones
+    // dan la misma estructura
+    void seed(uint64_t value) {
+        levels_.seed(value);
+    }
+    
     Iterator begin() {
-        return Iterator(header_->forward[0]);
+        return Iterator(next(header_, 0), header_);
     }
     
     Iterator end() {
-        return Iterator(nullptr);
+        return Iterator(nullptr, header_);
+    }
+    
+    ConstIterator begin() const {
+        return ConstIterator(next(header_, 0), header_);
+    }
+    
+    ConstIterator end() const {
+        return ConstIterator(nullptr, header_);
+    }
+    
+    ConstIterator cbegin() const {
+        return begin();
+    }
+    
+    ConstIterator cend() const {
+        return end();
+    }
+    
+    ReverseIterator rbegin() {
+        return ReverseIterator(end());
+    }
+    
+    ReverseIterator rend() {
+        return ReverseIterator(begin());
+    }
+    
+    ConstReverseIterator rbegin() const {
+        return ConstReverseIterator(end());
+    }
+    
+    ConstReverseIterator rend() const {
+        return ConstReverseIterator(begin());
+    }
+    
+    ConstReverseIterator crbegin() const {
+        return rbegin();
+    }
+    
+    ConstReverseIterator crend() const {
+        return rend();
+    }
+    
+    // Primer elemento (el minimo) en O(1), o end() si la lista esta vacia
+    Iterator front() {
+        return begin();
+    }
+    
+    ConstIterator front() const {
+        return cbegin();
+    }
+    
+    // Ultimo elemento en O(1), o end() si la lista esta vacia
+    Iterator last() {
+        return Iterator(header_->backward, header_);
+    }
+    
+    ConstIterator last() const {
+        return ConstIterator(header_->backward, header_);
+    }
+    
+    // Primer elemento con clave no menor que key
+    Iterator lower_bound(const K& key) {
+        return Iterator(findNode(key), header_);
+    }
+    
+    template<typename Key, typename C = Compare, typename = typename C::is_transparent>
+    Iterator lower_bound(const Key& key) {
+        return Iterator(findNode(key), header_);
+    }
+    
+    ConstIterator lower_bound(const K& key) const {
+        return ConstIterator(findNode(key), header_);
+    }
+    
+    template<typename Key, typename C = Compare, typename = typename C::is_transparent>
+    ConstIterator lower_bound(const Key& key) const {
+        return ConstIterator(findNode(key), header_);
+    }
+    
+    // Primer elemento con clave mayor que key
+    Iterator upper_bound(const K& key) {
+        return Iterator(findUpper(key), header_);
+    }
+    
+    template<typename Key, typename C = Compare, typename = typename C::is_transparent>
+    Iterator upper_bound(const Key& key) {
+        return Iterator(findUpper(key), header_);
+    }
+    
+    ConstIterator upper_bound(const K& key) const {
+        return ConstIterator(findUpper(key), header_);
+    }
+    
+    template<typename Key, typename C = Compare, typename = typename C::is_transparent>
+    ConstIterator upper_bound(const Key& key) const {
+        return ConstIterator(findUpper(key), header_);
+    }
+    
+    pair<Iterator, Iterator> equal_range(const K& key) {
+        pair<Node*, Node*> nodes = equalRangeImpl(key);
+        return make_pair(Iterator(nodes.first, header_), Iterator(nodes.second, header_));
+    }
+    
+    template<typename Key, typename C = Compare, typename = typename C::is_transparent>
+    pair<Iterator, Iterator> equal_range(const Key& key) {
+        pair<Node*, Node*> nodes = equalRangeImpl(key);
+        return make_pair(Iterator(nodes.first, header_), Iterator(nodes.second, header_));
+    }
+    
+    // Vista de los elementos con clave en [lo, hi), utilizable en un for de rango.
+    class Range {
+    private:
+        Iterator first_;
+        Iterator last_;
+        
+    public:
+        Range(Iterator first, Iterator last) : first_(first), last_(last) {}
+        
+        Iterator begin() const { return first_; }
+        Iterator end() const { return last_; }
+        bool empty() const { return first_ == last_; }
+    };
+    
+    Range range(const K& lo, const K& hi) {
+        Node* first = findNode(lo);
+        if (first == nullptr || !comp_(first->key, hi)) {
+            return Range(end(), end());
+        }
+        return Range(Iterator(first, header_), lower_bound(hi));
+    }
+    
+    // Llama f(key, value) para cada clave en [lo, hi), repartiendo el rango
+    // entre threads hilos (0: hardware_concurrency()). Cada elemento lo
+    // visita un solo hilo, pero sin orden entre tramos; la lista no debe
+    // modificarse mientras tanto.
+    template<typename F>
+    void parallel_for_each(const K& lo, const K& hi, F f, unsigned threads = 0) {
+        parallelWalk(lo, hi, threads, [&f](unsigned, Node* node, size_t count) {
+            for (size_t j = 0; j < count; j++, node = next(node, 0)) {
+                f(static_cast<const K&>(node->key), node->value);
+            }
+        });
+    }
+    
+    template<typename F>
+    void parallel_for_each(const K& lo, const K& hi, F f, unsigned threads = 0) const {
+        parallelWalk(lo, hi, threads, [&f](unsigned, Node* node, size_t count) {
+            for (size_t j = 0; j < count; j++, node = next(node, 0)) {
+                f(static_cast<const K&>(node->key), static_cast<const V&>(node->value));
+            }
+        });
+    }
+    
+    // Reduce map(key, value) sobre [lo, hi) con combine, en paralelo. identity
+    // debe ser neutro para combine; los parciales se combinan en el orden de
+    // las claves, asi que basta con que combine sea asociativa.
+    template<typename T, typename Map, typename Combine>
+    T parallel_reduce(const K& lo, const K& hi, T identity, Map map, Combine combine,
+                      unsigned threads = 0) const {
+        // Un struct por parcial: con T = bool, vector<bool> compartiria bytes
+        struct Partial {
+            T value;
+        };
+        vector<Partial> partial(parallelParts(size_, threads), Partial{identity});
+        parallelWalk(lo, hi, threads, [&](unsigned s, Node* node, size_t count) {
+            T acc = identity;
+            for (size_t j = 0; j < count; j++, node = next(node, 0)) {
+                acc = combine(acc, map(static_cast<const K&>(node->key), static_cast<const V&>(node->value)));
+            }
+            partial[s].value = acc;
+        });
+        T result = identity;
+        for (size_t s = 0; s < partial.size(); s++) {
+            result = combine(result, partial[s].value);
+        }
+        return result;
+    }
+    
+    // Reemplaza el contenido con pares (clave, valor) ya ordenados, en O(n).
+    // Con balanced = true los niveles son deterministas (posiciones multiplo
+    // de 1/p suben de nivel) en lugar de aleatorios. Lanza invalid_argument si
+    // la entrada no esta ordenada; en ese caso la lista no cambia. El
+    // generador de niveles (y su semilla) se conserva.
+    template<typename InputIt>
+    void assign_sorted(InputIt first, InputIt last, bool balanced = false) {
+        SkipList tmp(levelParam(), probability_, comp_, Alloc(alloc_));
+        tmp.levels_ = levels_;
+        tmp.buildSorted(first, last, balanced);
+        swap(tmp);
+    }
+    
+    template<typename InputIt>
+    static SkipList from_sorted(InputIt first, InputIt last, bool balanced = false,
+                                int maxLevel = 16, float probability = 0.5f) {
+        SkipList list(maxLevel, probability);
+        list.buildSorted(first, last, balanced);
+        return list;
+    }
+    
+    // from_sorted con varios hilos: cada uno crea los nodos de un tramo de la
+    // entrada y luego se unen. Requiere iteradores de acceso aleatorio; los
+    // niveles aleatorios se generan antes en el hilo actual.
+    template<typename RandomIt>
+    static SkipList parallel_from_sorted(RandomIt first, RandomIt last, bool balanced = false,
+                                         int maxLevel = 16, float probability = 0.5f,
+                                         unsigned threads = 0) {
+        SkipList list(maxLevel, probability);
+        list.buildSortedParallel(first, last, balanced, threads);
+        return list;
+    }
+    
+    // Inserta un lote sin ordenar: lo ordena y lo mezcla en un unico barrido
+    // con un dedo, en vez de una busqueda completa por clave. Claves ya
+    // presentes se actualizan (como insert); dentro del lote gana la ultima.
+    // Devuelve cuantas claves nuevas se insertaron.
+    template<typename InputIt>
+    size_t insert_batch(InputIt first, InputIt last) {
+        vector<pair<K, V>> batch(first, last);
+        const Compare& comp = comp_;
+        stable_sort(batch.begin(), batch.end(),
+                    [&comp](const pair<K, V>& a, const pair<K, V>& b) { return comp(a.first, b.first); });
+        
+        NodeBase* update[MAX_LEVEL + 1];
+        size_t ranks[MAX_LEVEL + 1];
+        for (int i = 0; i <= maxPossibleLevel_; i++) {
+            update[i] = header_;
+            ranks[i] = 0;
+        }
+        
+        size_t inserted = 0;
+        for (size_t b = 0; b < batch.size(); b++) {
+            if (b + 1 < batch.size() && !comp_(batch[b].first, batch[b + 1].first)) {
+                continue;  // repetida dentro del lote
+            }
+            const K& key = batch[b].first;
+            Node* current = advanceFinger(key, update, ranks);
+            if (current != nullptr && !comp_(key, current->key)) {
+                current->value = batch[b].second;
+                continue;
+            }
+            
+            int newLevel = randomLevel();
+            Node* newNode = createNode(newLevel, key, batch[b].second);
+            if (newLevel > maxLevel_) {
+                for (int i = maxLevel_ + 1; i <= newLevel; i++) {
+                    update[i] = header_;
+                    ranks[i] = 0;
+                    spans(header_)[i] = size_ + 1;
+                }
+                maxLevel_ = newLevel;
+            }
+            linkNode(newNode, update, ranks);
+            inserted++;
+        }
+        return inserted;
+    }
+    
+    // Guarda la lista (claves, valores y altura de cada torre) en el formato
+    // binario descrito en skiplist_detail. Con K y V trivialmente copiables
+    // se escriben columnas que MappedSkipList puede mapear; si no, cada
+    // entrada pasa por skiplist_codec. Lanza runtime_error si falla la
+    // escritura.
+    void save(const string& path) const {
+        ofstream out(path.c_str(), ios::binary | ios::trunc);
+        if (!out) {
+            throw runtime_error("No se pudo abrir " + path);
+        }
+        // La cabecera se reescribe al final con el tamaño y el checksum
+        skiplist_detail::writeHeader(out, FILE_FORMAT, FILE_KEY_SIZE, FILE_VALUE_SIZE, size_, 0, 0);
+        skiplist_detail::FileWriter writer(out);
+        saveBody(writer, RawFormat());
+        uint64_t payloadBytes = writer.finish();
+        skiplist_detail::writeHeader(out, FILE_FORMAT, FILE_KEY_SIZE, FILE_VALUE_SIZE,
+                                     size_, payloadBytes, writer.checksum());
+        out.flush();
+        if (!out) {
+            throw runtime_error("Error escribiendo " + path);
+        }
+    }
+    
+    // Reemplaza el contenido con el de un archivo de save(), en O(n) y con
+    // las mismas alturas de torre. Verifica cabecera, checksum y orden de las
+    // claves; si algo falla lanza runtime_error y la lista no cambia. El
+    // generador de niveles se conserva, como en assign_sorted.
+    void load(const string& path) {
+        vector<char> data = skiplist_detail::readFile(path);
+        skiplist_detail::FileHeader header = skiplist_detail::readHeader(
+            data.data(), data.size(), FILE_FORMAT, FILE_KEY_SIZE, FILE_VALUE_SIZE);
+        skiplist_detail::verifyChecksum(data.data(), header);
+        
+        SkipList tmp(levelParam(), probability_, comp_, Alloc(alloc_));
+        tmp.levels_ = levels_;
+        tmp.loadBody(data.data(), header, RawFormat());
+        swap(tmp);
+    }
+    
+    // Estadisticos de orden, O(log n) gracias a los spans de cada enlace.
+    
+    // Numero de elementos con clave menor que key (su posicion si existe)
+    size_t rank(const K& key) const {
+        NodeBase* update[MAX_LEVEL + 1];
+        size_t ranks[MAX_LEVEL + 1] = {};
+        findNode(key, update, ranks);
+        return ranks[0];
+    }
+    
+    // Elemento en la posicion index (desde 0), o end() si no existe
+    Iterator select(size_t index) {
+        return Iterator(selectNode(index), header_);
+    }
+    
+    size_t count_in_range(const K& lo, const K& hi) const {
+        if (!comp_(lo, hi)) {
+            return 0;
+        }
+        return rank(hi) - rank(lo);
+    }
+    
+    // Percentil p en [0, 100] por el metodo del rango mas cercano
+    Iterator percentile(double p) {
+        if (p < 0.0 || p > 100.0) {
+            throw invalid_argument("percentil debe estar entre 0 y 100");
+        }
+        if (size_ == 0) {
+            return end();
+        }
+        size_t index = static_cast<size_t>(ceil(p / 100.0 * static_cast<double>(size_)));
+        return select(index == 0 ? 0 : index - 1);
+    }
+    
+    // Avanza n posiciones en O(log n) en lugar de n pasos de operator++
+    Iterator advance(Iterator it, size_t n) {
+        if (it == end()) {
+            return end();
+        }
+        return select(rank(it.key()) + n);
+    }
+    
+    // Niveles y memoria se calculan recorriendo la lista, en O(n); los
+    // contadores por operacion solo existen compilando con SKIPLIST_STATS.
+    SkipListStats stats() const {
+        SkipListStats result;
+        result.size = size_;
+        result.maxLevel = maxLevel_;
+        result.levelNodes.assign(static_cast<size_t>(maxLevel_) + 1, 0);
+        
+        size_t links = 0;
+        size_t allocated = 0;
+        for (Node* n = next(header_, 0); n != nullptr; n = next(n, 0)) {
+            result.levelNodes[static_cast<size_t>(n->level)]++;
+            links += static_cast<size_t>(n->level) + 1;
+            allocated += nodeUnits(n->level) * sizeof(NodeUnit);
+        }
+        for (int i = maxLevel_; i > 0; i--) {
+            result.levelNodes[static_cast<size_t>(i) - 1] += result.levelNodes[static_cast<size_t>(i)];
+        }
+        result.keyValueBytes = size_ * (sizeof(K) + sizeof(V));
+        result.nodeOverheadBytes = size_ * (towerOffset() - sizeof(K) - sizeof(V));
+        result.towerBytes = links * sizeof(Node*);
+        result.spanBytes = links * sizeof(size_t);
+        result.headerBytes = nodeUnits(header_->level) * sizeof(NodeUnit);
+        result.totalBytes = allocated + result.headerBytes;
+        
+#ifdef SKIPLIST_STATS
+        result.countersEnabled = true;
+        result.searches = counters_.searches;
+        result.totalHops = counters_.hops;
+        result.maxHops = counters_.maxHops;
+        result.comparisons = counters_.comparisons;
+        result.inserts = counters_.ops[skiplist_detail::STAT_INSERT];
+        result.removes = counters_.ops[skiplist_detail::STAT_REMOVE];
+        result.lookups = counters_.ops[skiplist_detail::STAT_LOOKUP];
+        using skiplist_detail::LATENCY_BUCKETS;
+        const uint64_t* insertHist = counters_.latency[skiplist_detail::STAT_INSERT];
+        const uint64_t* removeHist = counters_.latency[skiplist_detail::STAT_REMOVE];
+        const uint64_t* lookupHist = counters_.latency[skiplist_detail::STAT_LOOKUP];
+        result.insertLatency.assign(insertHist, insertHist + LATENCY_BUCKETS);
+        result.removeLatency.assign(removeHist, removeHist + LATENCY_BUCKETS);
+        result.lookupLatency.assign(lookupHist, lookupHist + LATENCY_BUCKETS);
+#endif
+        return result;
+    }
+    
+    void reset_stats() {
+        counters_.reset();
     }
     
     void display() const {
         cout << "\n***** Skip List (size=" << size_ << ") *****\n";
         for (int i = maxLevel_; i >= 0; i--) {
-            Node* node = header_->forward[i];
+            Node* node = next(header_, i);
             cout << "Level " << i << ": ";
             while (node != nullptr) {
                 cout << "[" << node->key << ":" << node->value << "] ";
-                node = node->forward[i];
+                node = next(node, i);
             }
             cout << endl;
         }
@@ -411,13 +2839,21 @@ public:
         swap(maxPossibleLevel_, other.maxPossibleLevel_);
         swap(probability_, other.probability_);
         swap(size_, other.size_);
-        swap(rng_, other.rng_);
-        swap(dist_, other.dist_);
+        swap(levels_, other.levels_);
+        swap(autoLevel_, other.autoLevel_);
+        swap(levelCap_, other.levelCap_);
+        swap(capLow_, other.capLow_);
+        swap(capHigh_, other.capHigh_);
+        swap(alloc_, other.alloc_);
+        swap(comp_, other.comp_);
+        swap(finger_, other.finger_);
+        swap(fingerRanks_, other.fingerRanks_);
+        swap(fingerValid_, other.fingerValid_);
     }
 };
 
-template <typename K, typename V>
-void swap(SkipList<K, V>& a, SkipList<K, V>& b) noexcept {
+template <typename K, typename V, typename Compare, typename Alloc, typename LevelGen>
+void swap(SkipList<K, V, Compare, Alloc, LevelGen>& a, SkipList<K, V, Compare, Alloc, LevelGen>& b) noexcept {
     a.swap(b);
 }
 
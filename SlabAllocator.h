@@ -0,0 +1,170 @@
+#ifndef SLAB_ALLOCATOR_H
+#define SLAB_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+// Arena por bloques con listas libres por tamaño. En SkipList cada altura de
+// torre produce un tamaño de nodo distinto, asi que cada lista libre recicla
+// nodos de una misma altura.
+class SlabArena {
+private:
+    static const size_t GRANULE = alignof(max_align_t);
+    static const size_t MIN_CHUNK_BYTES = 16 * 1024;
+    static const size_t MAX_CHUNK_BYTES = 1024 * 1024;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    vector<void*> chunks_;
+    vector<FreeBlock*> freeLists_;  // indice = tamaño en granulos
+    char* cursor_;
+    char* limit_;
+    size_t nextChunkBytes_;
+    size_t chunkAllocations_;
+
+    static size_t granules(size_t bytes) {
+        return (bytes + GRANULE - 1) / GRANULE;
+    }
+
+    void refill(size_t bytes) {
+        size_t chunkBytes = nextChunkBytes_ > bytes ? nextChunkBytes_ : bytes;
+        char* chunk = static_cast<char*>(::operator new(chunkBytes));
+        chunks_.push_back(chunk);
+        chunkAllocations_++;
+        cursor_ = chunk;
+        limit_ = chunk + chunkBytes;
+        if (nextChunkBytes_ < MAX_CHUNK_BYTES) {
+            nextChunkBytes_ *= 2;
+        }
+    }
+
+public:
+    SlabArena()
+        : cursor_(nullptr)
+        , limit_(nullptr)
+        , nextChunkBytes_(MIN_CHUNK_BYTES)
+        , chunkAllocations_(0) {}
+
+    SlabArena(const SlabArena&) = delete;
+    SlabArena& operator=(const SlabArena&) = delete;
+
+    ~SlabArena() {
+        release();
+    }
+
+    void* allocate(size_t bytes) {
+        size_t cls = granules(bytes);
+        if (cls < freeLists_.size() && freeLists_[cls] != nullptr) {
+            FreeBlock* block = freeLists_[cls];
+            freeLists_[cls] = block->next;
+            return block;
+        }
+
+        size_t rounded = cls * GRANULE;
+        if (static_cast<size_t>(limit_ - cursor_) < rounded) {
+            refill(rounded);
+        }
+        void* result = cursor_;
+        cursor_ += rounded;
+        return result;
+    }
+
+    void deallocate(void* p, size_t bytes) noexcept {
+        size_t cls = granules(bytes);
+        if (cls >= freeLists_.size()) {
+            try {
+                freeLists_.resize(cls + 1, nullptr);
+            } catch (...) {
+                return;  // el bloque se recupera en release()
+            }
+        }
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->next = freeLists_[cls];
+        freeLists_[cls] = block;
+    }
+
+    // Devuelve todos los bloques al sistema de una sola vez.
+    void release() noexcept {
+        for (size_t i = 0; i < chunks_.size(); i++) {
+            ::operator delete(chunks_[i]);
+        }
+        chunks_.clear();
+        freeLists_.clear();
+        cursor_ = nullptr;
+        limit_ = nullptr;
+        nextChunkBytes_ = MIN_CHUNK_BYTES;
+    }
+
+    size_t chunkAllocations() const noexcept {
+        return chunkAllocations_;
+    }
+};
+
+// Allocator compatible con std::allocator sobre un SlabArena compartido por
+// todas sus copias. Una copia por defecto o select_on_container_copy_construction
+// crean un arena nuevo, de modo que cada SkipList tiene el suyo.
+template <typename T>
+class SlabAllocator {
+private:
+    template <typename U> friend class SlabAllocator;
+
+    shared_ptr<SlabArena> arena_;
+
+public:
+    static_assert(alignof(T) <= alignof(max_align_t), "SlabAllocator no soporta tipos sobre-alineados");
+
+    using value_type = T;
+    using propagate_on_container_copy_assignment = true_type;
+    using propagate_on_container_move_assignment = true_type;
+    using propagate_on_container_swap = true_type;
+
+    SlabAllocator() : arena_(make_shared<SlabArena>()) {}
+
+    template <typename U>
+    SlabAllocator(const SlabAllocator<U>& other) noexcept : arena_(other.arena_) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena_->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        arena_->deallocate(p, n * sizeof(T));
+    }
+
+    SlabAllocator select_on_container_copy_construction() const {
+        return SlabAllocator();
+    }
+
+    // Liberacion en bloque: solo es segura si ningun otro allocator comparte
+    // el arena. SkipList lo consulta antes de saltarse los deallocate por nodo.
+    bool can_release() const noexcept {
+        return arena_.use_count() == 1;
+    }
+
+    void release() noexcept {
+        arena_->release();
+    }
+
+    size_t chunk_allocations() const noexcept {
+        return arena_->chunkAllocations();
+    }
+
+    template <typename U>
+    bool operator==(const SlabAllocator<U>& other) const noexcept {
+        return arena_ == other.arena_;
+    }
+
+    template <typename U>
+    bool operator!=(const SlabAllocator<U>& other) const noexcept {
+        return arena_ != other.arena_;
+    }
+};
+
+#endif
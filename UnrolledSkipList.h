@@ -0,0 +1,683 @@
+#ifndef UNROLLED_SKIPLIST_H
+#define UNROLLED_SKIPLIST_H
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+namespace unrolled_detail {
+
+// Cantidad de claves menores que key en un bloque ordenado, es decir, su
+// lower_bound. Se cuenta sin saltos para que el compilador (o las rutas SIMD
+// de abajo) comparen varias claves por instruccion.
+template <typename K, typename Compare>
+size_t countLess(const K* keys, size_t n, const K& key, const Compare& comp) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        count += comp(keys[i], key) ? 1 : 0;
+    }
+    return count;
+}
+
+inline size_t popcount(unsigned mask) {
+    return bitset<32>(mask).count();
+}
+
+// Rutas SIMD segun el tamaño de K. Son plantillas sobre K para que el
+// recorrido final lea las claves con su propio tipo: long long e int64_t
+// pueden ser tipos distintos y leer uno como el otro rompe el aliasing.
+template <typename K>
+size_t countLessSimd(const K* keys, size_t n, K key, integral_constant<size_t, 4>) {
+    size_t count = 0;
+    size_t i = 0;
+#if defined(__AVX2__)
+    __m256i k = _mm256_set1_epi32(static_cast<int32_t>(key));
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        __m256i lt = _mm256_cmpgt_epi32(k, v);
+        count += popcount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(lt))));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    __m128i k = _mm_set1_epi32(static_cast<int32_t>(key));
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+        __m128i lt = _mm_cmplt_epi32(v, k);
+        count += popcount(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(lt))));
+    }
+#endif
+    for (; i < n; i++) {
+        count += keys[i] < key ? 1 : 0;
+    }
+    return count;
+}
+
+template <typename K>
+size_t countLessSimd(const K* keys, size_t n, K key, integral_constant<size_t, 8>) {
+    size_t count = 0;
+    size_t i = 0;
+#if defined(__AVX2__)
+    __m256i k = _mm256_set1_epi64x(static_cast<int64_t>(key));
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        __m256i lt = _mm256_cmpgt_epi64(k, v);
+        count += popcount(static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(lt))));
+    }
+#endif
+    for (; i < n; i++) {
+        count += keys[i] < key ? 1 : 0;
+    }
+    return count;
+}
+
+// Enteros con signo de 32 o 64 bits comparados con less usan la ruta SIMD;
+// el resto, la escalar.
+template <typename K, typename Compare>
+struct uses_simd
+    : integral_constant<bool, is_integral<K>::value && is_signed<K>::value &&
+                              (sizeof(K) == 4 || sizeof(K) == 8) &&
+                              is_same<Compare, less<K>>::value> {};
+
+template <typename K, typename Compare>
+size_t lowerIndex(const K* keys, size_t n, const K& key, const Compare& comp, false_type) {
+    return countLess(keys, n, key, comp);
+}
+
+template <typename K, typename Compare>
+size_t lowerIndex(const K* keys, size_t n, const K& key, const Compare&, true_type) {
+    return countLessSimd(keys, n, key, integral_constant<size_t, sizeof(K)>());
+}
+
+}
+
+// Skip list "desenrollada": el nivel 0 es una lista de bloques con hasta
+// BlockSize claves ordenadas y contiguas, y los niveles superiores indexan
+// bloques por su clave minima. Una busqueda da pocos saltos (hay n/BlockSize
+// bloques) y resuelve el final dentro de un bloque que ocupa lineas de cache
+// consecutivas, con comparaciones SIMD para enteros (AVX2 con -mavx2, si no
+// SSE2) y un recorrido escalar sin saltos para el resto.
+//
+// Misma interfaz basica que SkipList (insert, search, contains, find, at,
+// remove, Iterator), pero insertar o borrar mueve claves dentro del bloque,
+// asi que los iteradores se invalidan con cualquier modificacion.
+template <typename K, typename V, typename Compare = less<K>, size_t BlockSize = 32>
+class UnrolledSkipList {
+public:
+    static const int MAX_LEVEL = 32;
+
+private:
+    static_assert(BlockSize >= 4, "BlockSize debe ser al menos 4");
+
+    struct BlockBase {
+        int level;
+
+        explicit BlockBase(int lvl) : level(lvl) {}
+    };
+
+    // Claves y valores en arreglos separados para que la busqueda recorra solo
+    // claves. Los slots se construyen a medida que se ocupan.
+    struct Block : BlockBase {
+        size_t count;
+        typename aligned_storage<sizeof(K), alignof(K)>::type keySlots[BlockSize];
+        typename aligned_storage<sizeof(V), alignof(V)>::type valueSlots[BlockSize];
+
+        explicit Block(int level) : BlockBase(level), count(0) {}
+
+        ~Block() {
+            for (size_t i = 0; i < count; i++) {
+                keys()[i].~K();
+                values()[i].~V();
+            }
+        }
+
+        K* keys() { return reinterpret_cast<K*>(keySlots); }
+        const K* keys() const { return reinterpret_cast<const K*>(keySlots); }
+        V* values() { return reinterpret_cast<V*>(valueSlots); }
+    };
+
+    // Bloque: [Block | padding | Block* torre[level + 1]], como SkipList
+    static constexpr size_t towerOffset() {
+        return (sizeof(Block) + alignof(Block*) - 1) / alignof(Block*) * alignof(Block*);
+    }
+
+    static size_t blockBytes(int level) {
+        return towerOffset() + static_cast<size_t>(level + 1) * sizeof(Block*);
+    }
+
+    static Block** tower(BlockBase* block) {
+        return reinterpret_cast<Block**>(reinterpret_cast<char*>(block) + towerOffset());
+    }
+
+    static Block* next(BlockBase* block, int i) {
+        return tower(block)[i];
+    }
+
+    static Block* createBlock(int level) {
+        void* mem = ::operator new(blockBytes(level));
+        Block* block = ::new (mem) Block(level);
+        Block** links = tower(block);
+        for (int i = 0; i <= level; i++) {
+            links[i] = nullptr;
+        }
+        return block;
+    }
+
+    static void destroyBlock(Block* block) {
+        block->~Block();
+        ::operator delete(block);
+    }
+
+    // El header solo necesita la torre: no construye el bloque.
+    static BlockBase* createHeader(int level) {
+        void* mem = ::operator new(blockBytes(level));
+        BlockBase* header = ::new (mem) BlockBase(level);
+        Block** links = tower(header);
+        for (int i = 0; i <= level; i++) {
+            links[i] = nullptr;
+        }
+        return header;
+    }
+
+    static void destroyHeader(BlockBase* header) {
+        header->~BlockBase();
+        ::operator delete(header);
+    }
+
+    Compare comp_;
+    BlockBase* header_;
+    int maxPossibleLevel_;
+    float probability_;
+    int maxLevel_;
+    size_t size_;
+
+    mt19937 rng_;
+    uniform_real_distribution<float> dist_;
+
+    int randomLevel() {
+        int level = 0;
+        while (dist_(rng_) < probability_ && level < maxPossibleLevel_) {
+            level++;
+        }
+        return level;
+    }
+
+    void freeBlocks() {
+        Block* current = next(header_, 0);
+        while (current != nullptr) {
+            Block* following = next(current, 0);
+            destroyBlock(current);
+            current = following;
+        }
+    }
+
+    size_t lowerIndex(const Block* block, const K& key) const {
+        return unrolled_detail::lowerIndex(block->keys(), block->count, key, comp_,
+                                           unrolled_detail::uses_simd<K, Compare>());
+    }
+
+    // Ultimo bloque cuya clave minima es <= key, o el header si key es menor
+    // que todas. Si update no es nulo recibe el ultimo bloque de cada nivel
+    // 0..maxLevel_ que cumple lo mismo.
+    BlockBase* findBlock(const K& key, BlockBase** update = nullptr) const {
+        BlockBase* current = header_;
+        for (int i = maxLevel_; i >= 0; i--) {
+            Block* candidate;
+            while ((candidate = next(current, i)) != nullptr && !comp_(key, candidate->keys()[0])) {
+                current = candidate;
+            }
+            if (update) update[i] = current;
+        }
+        return current;
+    }
+
+    // Bloque e indice de key, o (nullptr, 0) si no esta
+    pair<Block*, size_t> locate(const K& key) const {
+        BlockBase* found = findBlock(key);
+        if (found == header_) {
+            return make_pair(static_cast<Block*>(nullptr), size_t(0));
+        }
+        Block* block = static_cast<Block*>(found);
+        size_t idx = lowerIndex(block, key);
+        if (idx < block->count && !comp_(key, block->keys()[idx])) {
+            return make_pair(block, idx);
+        }
+        return make_pair(static_cast<Block*>(nullptr), size_t(0));
+    }
+
+    // Inserta en el hueco idx de un bloque con espacio, desplazando el resto
+    static void insertAt(Block* block, size_t idx, const K& key, const V& value) {
+        K* keys = block->keys();
+        V* values = block->values();
+        size_t n = block->count;
+        if (idx == n) {
+            ::new (&keys[n]) K(key);
+            try {
+                ::new (&values[n]) V(value);
+            } catch (...) {
+                keys[n].~K();
+                throw;
+            }
+        } else {
+            // Copias primero: si lanzan, el bloque no cambia
+            K k(key);
+            V v(value);
+            ::new (&keys[n]) K(std::move(keys[n - 1]));
+            ::new (&values[n]) V(std::move(values[n - 1]));
+            std::move_backward(keys + idx, keys + n - 1, keys + n);
+            std::move_backward(values + idx, values + n - 1, values + n);
+            keys[idx] = std::move(k);
+            values[idx] = std::move(v);
+        }
+        block->count++;
+    }
+
+    static void eraseAt(Block* block, size_t idx) {
+        K* keys = block->keys();
+        V* values = block->values();
+        size_t n = block->count;
+        std::move(keys + idx + 1, keys + n, keys + idx);
+        std::move(values + idx + 1, values + n, values + idx);
+        keys[n - 1].~K();
+        values[n - 1].~V();
+        block->count--;
+    }
+
+    // Mueve las entradas [from, count) de src al final de dst
+    static void moveTail(Block* src, size_t from, Block* dst) {
+        K* keys = src->keys();
+        V* values = src->values();
+        for (size_t i = from; i < src->count; i++) {
+            ::new (&dst->keys()[dst->count]) K(std::move(keys[i]));
+            ::new (&dst->values()[dst->count]) V(std::move(values[i]));
+            dst->count++;
+        }
+        for (size_t i = from; i < src->count; i++) {
+            keys[i].~K();
+            values[i].~V();
+        }
+        src->count = from;
+    }
+
+    // Enlaza un bloque nuevo detras de update[i] en cada uno de sus niveles
+    Block* linkNewBlock(BlockBase** update) {
+        int level = randomLevel();
+        Block* block = createBlock(level);
+        if (level > maxLevel_) {
+            for (int i = maxLevel_ + 1; i <= level; i++) {
+                update[i] = header_;
+            }
+            maxLevel_ = level;
+        }
+        for (int i = 0; i <= level; i++) {
+            tower(block)[i] = next(update[i], i);
+            tower(update[i])[i] = block;
+        }
+        return block;
+    }
+
+    // Desenlaza target de todos sus niveles. key debe ser >= su clave minima
+    // y menor que la del bloque siguiente.
+    void unlinkBlock(Block* target, const K& key) {
+        BlockBase* current = header_;
+        for (int i = maxLevel_; i >= 0; i--) {
+            Block* candidate;
+            while ((candidate = next(current, i)) != nullptr && candidate != target &&
+                   !comp_(key, candidate->keys()[0])) {
+                current = candidate;
+            }
+            if (i <= target->level) {
+                tower(current)[i] = next(target, i);
+            }
+        }
+        destroyBlock(target);
+        while (maxLevel_ > 0 && next(header_, maxLevel_) == nullptr) {
+            maxLevel_--;
+        }
+    }
+
+    void copyFrom(const UnrolledSkipList& other) {
+        header_ = createHeader(maxPossibleLevel_);
+        BlockBase* update[MAX_LEVEL + 1];
+        for (int i = 0; i <= maxPossibleLevel_; i++) {
+            update[i] = header_;
+        }
+        try {
+            for (Block* src = next(other.header_, 0); src != nullptr; src = next(src, 0)) {
+                Block* block = createBlock(src->level);
+                for (int i = 0; i <= src->level; i++) {
+                    tower(update[i])[i] = block;
+                    update[i] = block;
+                }
+                for (size_t j = 0; j < src->count; j++) {
+                    insertAt(block, j, src->keys()[j], src->values()[j]);
+                }
+            }
+        } catch (...) {
+            freeBlocks();
+            destroyHeader(header_);
+            throw;
+        }
+    }
+
+public:
+    class Iterator {
+    private:
+        friend class UnrolledSkipList;
+
+        Block* block_;
+        size_t index_;
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = pair<K&, V&>;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type*;
+        using reference = value_type;
+
+        Iterator(Block* block, size_t index) : block_(block), index_(index) {}
+
+        reference operator*() const {
+            return {block_->keys()[index_], block_->values()[index_]};
+        }
+
+        Iterator& operator++() {
+            if (block_ && ++index_ == block_->count) {
+                block_ = next(block_, 0);
+                index_ = 0;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return block_ == other.block_ && index_ == other.index_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+
+        const K& key() const { return block_->keys()[index_]; }
+        V& value() { return block_->values()[index_]; }
+        const V& value() const { return block_->values()[index_]; }
+    };
+
+    explicit UnrolledSkipList(int maxLevel = 16, float probability = 0.5f, const Compare& comp = Compare())
+        : comp_(comp)
+        , header_(nullptr)
+        , maxPossibleLevel_(maxLevel)
+        , probability_(probability)
+        , maxLevel_(0)
+        , size_(0)
+        , rng_(random_device{}())
+        , dist_(0.0f, 1.0f) {
+
+        if (maxLevel < 0 || maxLevel > MAX_LEVEL) {
+            throw invalid_argument("maxLevel debe estar entre 0 y 32");
+        }
+        if (probability <= 0.0f || probability >= 1.0f) {
+            throw invalid_argument("probability debe estar entre 0 y 1 (exclusivo)");
+        }
+
+        header_ = createHeader(maxPossibleLevel_);
+    }
+
+    ~UnrolledSkipList() {
+        freeBlocks();
+        destroyHeader(header_);
+    }
+
+    UnrolledSkipList(const UnrolledSkipList& other)
+        : comp_(other.comp_)
+        , header_(nullptr)
+        , maxPossibleLevel_(other.maxPossibleLevel_)
+        , probability_(other.probability_)
+        , maxLevel_(other.maxLevel_)
+        , size_(other.size_)
+        , rng_(random_device{}())
+        , dist_(0.0f, 1.0f) {
+        copyFrom(other);
+    }
+
+    UnrolledSkipList& operator=(const UnrolledSkipList& other) {
+        if (this != &other) {
+            UnrolledSkipList tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    UnrolledSkipList(UnrolledSkipList&& other) noexcept
+        : comp_(other.comp_)
+        , header_(other.header_)
+        , maxPossibleLevel_(other.maxPossibleLevel_)
+        , probability_(other.probability_)
+        , maxLevel_(other.maxLevel_)
+        , size_(other.size_)
+        , rng_(move(other.rng_))
+        , dist_(move(other.dist_)) {
+
+        other.header_ = createHeader(other.maxPossibleLevel_);
+        other.maxLevel_ = 0;
+        other.size_ = 0;
+    }
+
+    UnrolledSkipList& operator=(UnrolledSkipList&& other) noexcept {
+        if (this != &other) {
+            UnrolledSkipList tmp(move(other));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    bool insert(const K& key, const V& value) {
+        BlockBase* update[MAX_LEVEL + 1];
+        BlockBase* found = findBlock(key, update);
+
+        Block* block;
+        if (found == header_) {
+            // Menor que todas las claves: va al principio del primer bloque
+            block = next(header_, 0);
+            if (block == nullptr) {
+                block = linkNewBlock(update);
+            }
+            for (int i = 0; i <= block->level; i++) {
+                update[i] = block;
+            }
+        } else {
+            block = static_cast<Block*>(found);
+        }
+
+        size_t idx = lowerIndex(block, key);
+        if (idx < block->count && !comp_(key, block->keys()[idx])) {
+            block->values()[idx] = value;
+            return false;
+        }
+
+        if (block->count == BlockSize) {
+            Block* fresh = linkNewBlock(update);
+            if (idx == BlockSize && next(fresh, 0) == nullptr) {
+                // Insercion al final: el bloque lleno se queda lleno
+                try {
+                    insertAt(fresh, 0, key, value);
+                } catch (...) {
+                    unlinkBlock(fresh, key);
+                    throw;
+                }
+                size_++;
+                return true;
+            } else {
+                size_t half = BlockSize / 2;
+                moveTail(block, half, fresh);
+                if (idx > half) {
+                    block = fresh;
+                    idx -= half;
+                }
+            }
+        }
+
+        insertAt(block, idx, key, value);
+        size_++;
+        return true;
+    }
+
+    bool search(const K& key, V& value) const {
+        pair<Block*, size_t> pos = locate(key);
+        if (pos.first == nullptr) {
+            return false;
+        }
+        value = pos.first->values()[pos.second];
+        return true;
+    }
+
+    bool contains(const K& key) const {
+        return locate(key).first != nullptr;
+    }
+
+    Iterator find(const K& key) {
+        pair<Block*, size_t> pos = locate(key);
+        return pos.first == nullptr ? end() : Iterator(pos.first, pos.second);
+    }
+
+    V& at(const K& key) {
+        pair<Block*, size_t> pos = locate(key);
+        if (pos.first == nullptr) {
+            throw out_of_range("Clave no encontrada en UnrolledSkipList");
+        }
+        return pos.first->values()[pos.second];
+    }
+
+    const V& at(const K& key) const {
+        return const_cast<UnrolledSkipList*>(this)->at(key);
+    }
+
+    Iterator lower_bound(const K& key) {
+        BlockBase* found = findBlock(key);
+        Block* block = found == header_ ? next(header_, 0) : static_cast<Block*>(found);
+        if (block == nullptr) {
+            return end();
+        }
+        size_t idx = lowerIndex(block, key);
+        if (idx == block->count) {
+            return Iterator(next(block, 0), 0);
+        }
+        return Iterator(block, idx);
+    }
+
+    // Un bloque que queda vacio se desenlaza; uno que queda a menos de un
+    // cuarto de su capacidad absorbe al siguiente si ambos caben en la mitad.
+    bool remove(const K& key) {
+        pair<Block*, size_t> pos = locate(key);
+        Block* block = pos.first;
+        if (block == nullptr) {
+            return false;
+        }
+
+        eraseAt(block, pos.second);
+        size_--;
+
+        if (block->count == 0) {
+            unlinkBlock(block, key);
+        } else if (block->count < BlockSize / 4) {
+            Block* following = next(block, 0);
+            if (following != nullptr && block->count + following->count <= BlockSize / 2) {
+                K lastKey(following->keys()[following->count - 1]);
+                moveTail(following, 0, block);
+                unlinkBlock(following, lastKey);
+            }
+        }
+        return true;
+    }
+
+    bool erase(const K& key) {
+        return remove(key);
+    }
+
+    void clear() {
+        freeBlocks();
+        for (int i = 0; i <= maxPossibleLevel_; i++) {
+            tower(header_)[i] = nullptr;
+        }
+        maxLevel_ = 0;
+        size_ = 0;
+    }
+
+    size_t size() const noexcept {
+        return size_;
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    int maxLevel() const noexcept {
+        return maxLevel_;
+    }
+
+    size_t blockCount() const {
+        size_t blocks = 0;
+        for (Block* b = next(header_, 0); b != nullptr; b = next(b, 0)) {
+            blocks++;
+        }
+        return blocks;
+    }
+
+    Iterator begin() {
+        return Iterator(next(header_, 0), 0);
+    }
+
+    Iterator end() {
+        return Iterator(nullptr, 0);
+    }
+
+    void display() const {
+        cout << "\n***** Unrolled Skip List (size=" << size_ << ") *****\n";
+        for (int i = maxLevel_; i >= 0; i--) {
+            cout << "Level " << i << ": ";
+            for (Block* b = next(header_, i); b != nullptr; b = next(b, i)) {
+                cout << "[" << b->keys()[0] << ".." << b->keys()[b->count - 1] << " (" << b->count << ")] ";
+            }
+            cout << endl;
+        }
+        cout << "*********************\n";
+    }
+
+    void swap(UnrolledSkipList& other) noexcept {
+        using std::swap;
+        swap(header_, other.header_);
+        swap(maxLevel_, other.maxLevel_);
+        swap(maxPossibleLevel_, other.maxPossibleLevel_);
+        swap(probability_, other.probability_);
+        swap(size_, other.size_);
+        swap(rng_, other.rng_);
+        swap(dist_, other.dist_);
+        swap(comp_, other.comp_);
+    }
+};
+
+template <typename K, typename V, typename Compare, size_t BlockSize>
+void swap(UnrolledSkipList<K, V, Compare, BlockSize>& a, UnrolledSkipList<K, V, Compare, BlockSize>& b) noexcept {
+    a.swap(b);
+}
+
+#endif
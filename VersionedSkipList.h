@@ -0,0 +1,547 @@
+#ifndef VERSIONED_SKIPLIST_H
+#define VERSIONED_SKIPLIST_H
+
+#include "EpochReclamation.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+// Skip list multiversion (MVCC) al estilo de la memtable de un motor LSM.
+// Cada clave guarda una cadena de versiones, de la mas nueva a la mas vieja,
+// etiquetadas con un numero de secuencia global; remove() agrega una lapida.
+// Un Snapshot fija una secuencia y todas sus lecturas e iteradores ven el
+// estado de ese instante, aunque haya escrituras en paralelo.
+//
+// Las escrituras (put, remove, gc) se serializan con un mutex; las lecturas
+// no toman locks: los enlaces son atomicos y se publican con release, y lo
+// que gc() desenlaza se libera a traves de EpochManager.
+template <typename K, typename V, typename Compare = less<K>>
+class VersionedSkipList {
+public:
+    static const int MAX_LEVEL = 32;
+
+private:
+    // Una version inmutable del valor. El valor solo se construye si no es
+    // una lapida. older es atomico porque gc() corta la cadena mientras
+    // otros hilos la recorren.
+    struct Version {
+        uint64_t seq;
+        bool deleted;
+        atomic<Version*> older;
+        typename aligned_storage<sizeof(V), alignof(V)>::type storage;
+
+        Version(uint64_t s, Version* next) : seq(s), deleted(true), older(next) {}
+
+        Version(uint64_t s, const V& value, Version* next) : seq(s), deleted(false), older(next) {
+            ::new (&storage) V(value);
+        }
+
+        ~Version() {
+            if (!deleted) this->value().~V();
+        }
+
+        const V& value() const { return *reinterpret_cast<const V*>(&storage); }
+    };
+
+    struct Node {
+        K key;
+        int level;
+        atomic<Version*> versions;
+
+        Node(const K& k, int lvl, Version* first) : key(k), level(lvl), versions(first) {}
+    };
+
+    typedef atomic<Node*> Link;
+
+    // Bloque de un nodo: [Node | padding | Link torre[level + 1]], igual que SkipList
+    static constexpr size_t towerOffset() {
+        return (sizeof(Node) + alignof(Link) - 1) / alignof(Link) * alignof(Link);
+    }
+
+    static size_t nodeBytes(int level) {
+        return towerOffset() + static_cast<size_t>(level + 1) * sizeof(Link);
+    }
+
+    static Link* tower(Node* node) {
+        return reinterpret_cast<Link*>(reinterpret_cast<char*>(node) + towerOffset());
+    }
+
+    static Node* createNode(const K& key, int level, Version* first) {
+        void* mem = ::operator new(nodeBytes(level));
+        Node* node;
+        try {
+            node = ::new (mem) Node(key, level, first);
+        } catch (...) {
+            ::operator delete(mem);
+            throw;
+        }
+        Link* links = tower(node);
+        for (int i = 0; i <= level; i++) {
+            ::new (&links[i]) Link(nullptr);
+        }
+        return node;
+    }
+
+    static void destroyChain(void* ptr) {
+        Version* version = static_cast<Version*>(ptr);
+        while (version != nullptr) {
+            Version* older = version->older.load(memory_order_relaxed);
+            delete version;
+            version = older;
+        }
+    }
+
+    static void destroyNode(void* ptr) {
+        Node* node = static_cast<Node*>(ptr);
+        destroyChain(node->versions.load(memory_order_relaxed));
+        node->~Node();
+        ::operator delete(ptr);
+    }
+
+    // El header no construye K: solo su torre.
+    static Link* createHeader() {
+        void* mem = ::operator new(static_cast<size_t>(MAX_LEVEL + 1) * sizeof(Link));
+        Link* links = static_cast<Link*>(mem);
+        for (int i = 0; i <= MAX_LEVEL; i++) {
+            ::new (&links[i]) Link(nullptr);
+        }
+        return links;
+    }
+
+    // Version de node visible en la secuencia seq, o nullptr si no existe o
+    // es una lapida.
+    static const Version* visible(Node* node, uint64_t seq) {
+        const Version* version = node->versions.load(memory_order_acquire);
+        while (version != nullptr && version->seq > seq) {
+            version = version->older.load(memory_order_acquire);
+        }
+        return version != nullptr && !version->deleted ? version : nullptr;
+    }
+
+    Compare comp_;
+    Link* head_;
+    atomic<int> height_;
+    atomic<uint64_t> lastSeq_;
+    atomic<size_t> size_;
+    float probability_;
+    int maxPossibleLevel_;
+
+    mutex writeMutex_;
+    mt19937 rng_;
+    uniform_real_distribution<float> dist_;
+
+    mutable mutex snapshotsMutex_;
+    mutable multiset<uint64_t> snapshots_;
+
+    int randomLevel() {
+        int level = 0;
+        while (dist_(rng_) < probability_ && level < maxPossibleLevel_) {
+            level++;
+        }
+        return level;
+    }
+
+    Link* linksOf(Node* node) const {
+        return node == nullptr ? head_ : tower(node);
+    }
+
+    // Primer nodo con clave >= key. preds[i] == nullptr representa el header.
+    // Devuelve el sucesor ya comparado: releer el enlace podria dar un nodo
+    // insertado despues, con clave menor.
+    Node* findNode(const K& key, Node** preds = nullptr) const {
+        Node* pred = nullptr;
+        Node* candidate = nullptr;
+        for (int i = height_.load(memory_order_acquire); i >= 0; i--) {
+            while ((candidate = linksOf(pred)[i].load(memory_order_acquire)) != nullptr &&
+                   comp_(candidate->key, key)) {
+                pred = candidate;
+            }
+            if (preds) preds[i] = pred;
+        }
+        return candidate;
+    }
+
+    Node* findEqual(const K& key) const {
+        Node* node = findNode(key);
+        return node != nullptr && !comp_(key, node->key) ? node : nullptr;
+    }
+
+    // Antepone una version (o crea el nodo) y publica la secuencia. Debe
+    // llamarse con writeMutex_ tomado.
+    template <typename Make>
+    bool write(const K& key, Make make) {
+        Node* preds[MAX_LEVEL + 1];
+        Node* node = findNode(key, preds);
+        uint64_t seq = lastSeq_.load(memory_order_relaxed) + 1;
+
+        bool wasLive;
+        if (node != nullptr && !comp_(key, node->key)) {
+            Version* head = node->versions.load(memory_order_relaxed);
+            wasLive = !head->deleted;
+            node->versions.store(make(seq, head), memory_order_release);
+        } else {
+            wasLive = false;
+            Version* first = make(seq, nullptr);
+            int level = randomLevel();
+            try {
+                node = createNode(key, level, first);
+            } catch (...) {
+                delete first;
+                throw;
+            }
+            int height = height_.load(memory_order_relaxed);
+            for (int i = height + 1; i <= level; i++) {
+                preds[i] = nullptr;
+            }
+            // Primero los enlaces propios, despues la publicacion de abajo arriba
+            for (int i = 0; i <= level; i++) {
+                tower(node)[i].store(linksOf(preds[i])[i].load(memory_order_relaxed), memory_order_relaxed);
+            }
+            for (int i = 0; i <= level; i++) {
+                linksOf(preds[i])[i].store(node, memory_order_release);
+            }
+            if (level > height) {
+                height_.store(level, memory_order_release);
+            }
+        }
+        lastSeq_.store(seq, memory_order_release);
+        return wasLive;
+    }
+
+    void registerSnapshot(uint64_t& seq) const {
+        lock_guard<mutex> lock(snapshotsMutex_);
+        seq = lastSeq_.load(memory_order_acquire);
+        snapshots_.insert(seq);
+    }
+
+    void releaseSnapshot(uint64_t seq) const {
+        lock_guard<mutex> lock(snapshotsMutex_);
+        snapshots_.erase(snapshots_.find(seq));
+    }
+
+    uint64_t oldestSnapshot() const {
+        lock_guard<mutex> lock(snapshotsMutex_);
+        return snapshots_.empty() ? lastSeq_.load(memory_order_acquire) : *snapshots_.begin();
+    }
+
+    void freeAll() {
+        Node* current = head_[0].load(memory_order_relaxed);
+        while (current != nullptr) {
+            Node* following = tower(current)[0].load(memory_order_relaxed);
+            destroyNode(current);
+            current = following;
+        }
+    }
+
+public:
+    class Snapshot;
+
+    // Iterador de un Snapshot: recorre en orden las claves visibles en su
+    // secuencia. Valido mientras viva el Snapshot que lo creo.
+    class Iterator {
+    private:
+        friend class Snapshot;
+
+        Node* node_;
+        const Version* version_;
+        uint64_t seq_;
+
+        Iterator(Node* node, uint64_t seq) : node_(node), version_(nullptr), seq_(seq) {
+            settle();
+        }
+
+        // Avanza hasta el primer nodo con una version visible. Los nodos que
+        // gc() desenlaza no son visibles para ningun snapshot vivo, asi que
+        // el iterador nunca se queda en uno.
+        void settle() {
+            while (node_ != nullptr && (version_ = visible(node_, seq_)) == nullptr) {
+                node_ = tower(node_)[0].load(memory_order_acquire);
+            }
+        }
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = pair<const K&, const V&>;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type*;
+        using reference = value_type;
+
+        reference operator*() const {
+            return {node_->key, version_->value()};
+        }
+
+        Iterator& operator++() {
+            if (node_) {
+                EpochGuard guard;
+                node_ = tower(node_)[0].load(memory_order_acquire);
+                settle();
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return node_ == other.node_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return node_ != other.node_;
+        }
+
+        const K& key() const { return node_->key; }
+        const V& value() const { return version_->value(); }
+    };
+
+    // Vista de solo lectura en un instante. Mientras exista, gc() conserva las
+    // versiones que necesita.
+    class Snapshot {
+    private:
+        friend class VersionedSkipList;
+
+        const VersionedSkipList* list_;
+        uint64_t seq_;
+
+        explicit Snapshot(const VersionedSkipList* list) : list_(list), seq_(0) {
+            list_->registerSnapshot(seq_);
+        }
+
+    public:
+        Snapshot(Snapshot&& other) noexcept : list_(other.list_), seq_(other.seq_) {
+            other.list_ = nullptr;
+        }
+
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+        Snapshot& operator=(Snapshot&&) = delete;
+
+        ~Snapshot() {
+            if (list_ != nullptr) {
+                list_->releaseSnapshot(seq_);
+            }
+        }
+
+        uint64_t sequence() const noexcept {
+            return seq_;
+        }
+
+        bool get(const K& key, V& value) const {
+            EpochGuard guard;
+            Node* node = list_->findEqual(key);
+            const Version* version = node != nullptr ? visible(node, seq_) : nullptr;
+            if (version == nullptr) {
+                return false;
+            }
+            value = version->value();
+            return true;
+        }
+
+        bool contains(const K& key) const {
+            EpochGuard guard;
+            Node* node = list_->findEqual(key);
+            return node != nullptr && visible(node, seq_) != nullptr;
+        }
+
+        Iterator begin() const {
+            EpochGuard guard;
+            return Iterator(list_->head_[0].load(memory_order_acquire), seq_);
+        }
+
+        Iterator end() const {
+            return Iterator(nullptr, seq_);
+        }
+
+        Iterator lower_bound(const K& key) const {
+            EpochGuard guard;
+            return Iterator(list_->findNode(key), seq_);
+        }
+    };
+
+    explicit VersionedSkipList(int maxLevel = 16, float probability = 0.5f, const Compare& comp = Compare())
+        : comp_(comp)
+        , head_(nullptr)
+        , height_(0)
+        , lastSeq_(0)
+        , size_(0)
+        , probability_(probability)
+        , maxPossibleLevel_(maxLevel)
+        , rng_(random_device{}())
+        , dist_(0.0f, 1.0f) {
+
+        if (maxLevel < 0 || maxLevel > MAX_LEVEL) {
+            throw invalid_argument("maxLevel debe estar entre 0 y 32");
+        }
+        if (probability <= 0.0f || probability >= 1.0f) {
+            throw invalid_argument("probability debe estar entre 0 y 1 (exclusivo)");
+        }
+
+        head_ = createHeader();
+    }
+
+    // Exige que no queden snapshots ni otros hilos usando la lista.
+    ~VersionedSkipList() {
+        freeAll();
+        ::operator delete(head_);
+    }
+
+    VersionedSkipList(const VersionedSkipList&) = delete;
+    VersionedSkipList& operator=(const VersionedSkipList&) = delete;
+
+    // Nueva version de key. Devuelve true si la clave no estaba viva.
+    bool put(const K& key, const V& value) {
+        lock_guard<mutex> lock(writeMutex_);
+        bool wasLive = write(key, [&value](uint64_t seq, Version* older) {
+            return new Version(seq, value, older);
+        });
+        if (!wasLive) size_.fetch_add(1, memory_order_relaxed);
+        return !wasLive;
+    }
+
+    bool insert(const K& key, const V& value) {
+        return put(key, value);
+    }
+
+    // Agrega una lapida; los snapshots anteriores siguen viendo el valor.
+    bool remove(const K& key) {
+        lock_guard<mutex> lock(writeMutex_);
+        Node* node = findEqual(key);
+        if (node == nullptr || node->versions.load(memory_order_relaxed)->deleted) {
+            return false;
+        }
+        write(key, [](uint64_t seq, Version* older) {
+            return new Version(seq, older);
+        });
+        size_.fetch_sub(1, memory_order_relaxed);
+        return true;
+    }
+
+    bool erase(const K& key) {
+        return remove(key);
+    }
+
+    // Lectura de la ultima version, sin snapshot
+    bool get(const K& key, V& value) const {
+        EpochGuard guard;
+        Node* node = findEqual(key);
+        if (node == nullptr) {
+            return false;
+        }
+        const Version* head = node->versions.load(memory_order_acquire);
+        if (head->deleted) {
+            return false;
+        }
+        value = head->value();
+        return true;
+    }
+
+    bool search(const K& key, V& value) const {
+        return get(key, value);
+    }
+
+    bool contains(const K& key) const {
+        EpochGuard guard;
+        Node* node = findEqual(key);
+        return node != nullptr && !node->versions.load(memory_order_acquire)->deleted;
+    }
+
+    Snapshot snapshot() const {
+        return Snapshot(this);
+    }
+
+    // Descarta las versiones que ningun snapshot vivo puede ver: por clave se
+    // conserva la mas nueva con secuencia <= el snapshot mas antiguo (y las
+    // posteriores); si esa es una lapida sin versiones nuevas, se desenlaza
+    // la clave. O(n). Devuelve cuantas versiones se descartaron.
+    size_t gc() {
+        lock_guard<mutex> lock(writeMutex_);
+        uint64_t oldest = oldestSnapshot();
+
+        Node* update[MAX_LEVEL + 1];
+        for (int i = 0; i <= MAX_LEVEL; i++) {
+            update[i] = nullptr;
+        }
+        size_t discarded = 0;
+        Node* current = head_[0].load(memory_order_relaxed);
+        while (current != nullptr) {
+            Node* following = tower(current)[0].load(memory_order_relaxed);
+            Version* head = current->versions.load(memory_order_relaxed);
+            Version* boundary = head;
+            while (boundary != nullptr && boundary->seq > oldest) {
+                boundary = boundary->older.load(memory_order_relaxed);
+            }
+
+            if (boundary != nullptr) {
+                Version* rest = boundary->older.exchange(nullptr, memory_order_acq_rel);
+                for (Version* v = rest; v != nullptr; v = v->older.load(memory_order_relaxed)) {
+                    discarded++;
+                }
+                if (rest != nullptr) {
+                    EpochManager::instance().retire(rest, &VersionedSkipList::destroyChain);
+                }
+            }
+
+            if (boundary == head && head->deleted) {
+                for (int i = 0; i <= current->level; i++) {
+                    linksOf(update[i])[i].store(tower(current)[i].load(memory_order_relaxed),
+                                                memory_order_release);
+                }
+                EpochManager::instance().retire(current, &VersionedSkipList::destroyNode);
+                discarded++;
+            } else {
+                for (int i = 0; i <= current->level; i++) {
+                    update[i] = current;
+                }
+            }
+            current = following;
+        }
+
+        int height = height_.load(memory_order_relaxed);
+        while (height > 0 && head_[height].load(memory_order_relaxed) == nullptr) {
+            height--;
+        }
+        height_.store(height, memory_order_release);
+        return discarded;
+    }
+
+    // Claves vivas en la ultima version
+    size_t size() const noexcept {
+        return size_.load(memory_order_relaxed);
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    uint64_t sequence() const noexcept {
+        return lastSeq_.load(memory_order_acquire);
+    }
+
+    // Versiones almacenadas, lapidas incluidas. Recorre toda la lista.
+    size_t version_count() const {
+        EpochGuard guard;
+        size_t count = 0;
+        for (Node* n = head_[0].load(memory_order_acquire); n != nullptr;
+             n = tower(n)[0].load(memory_order_acquire)) {
+            for (Version* v = n->versions.load(memory_order_acquire); v != nullptr;
+                 v = v->older.load(memory_order_acquire)) {
+                count++;
+            }
+        }
+        return count;
+    }
+};
+
+#endif
@@ -0,0 +1,66 @@
+// Benchmark de allocators: llamadas a operator new y latencia de clear() y
+// del destructor con std::allocator frente a SlabAllocator.
+//
+// Compilar (desde la raiz del repositorio):
+//   g++ -O2 -std=c++11 -I. -o bench_allocator benchmarks/bench_allocator.cpp
+//   ./bench_allocator [n1 n2 ...]      (por defecto 1000000 10000000)
+
+#define BENCH_COUNT_ALLOCATIONS
+
+#include "SkipList.h"
+#include "SlabAllocator.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+
+template <typename List>
+void run(const char* name, const vector<int>& keys) {
+    size_t n = keys.size();
+    List* sl = new List();
+
+    size_t allocs = g_allocations;
+    Clock::time_point t = Clock::now();
+    for (int k : keys) sl->insert(k, k);
+    double insertNs = nsPerOp(t, n);
+    size_t insertAllocs = g_allocations - allocs;
+
+    t = Clock::now();
+    sl->clear();
+    double clearMs = msSince(t);
+
+    allocs = g_allocations;
+    for (int k : keys) sl->insert(k, k);
+    size_t refillAllocs = g_allocations - allocs;
+
+    t = Clock::now();
+    delete sl;
+    double destroyMs = msSince(t);
+
+    printf("%-16s %10zu %12.1f %14zu %14zu %10.2f %10.2f\n",
+           name, n, insertNs, insertAllocs, refillAllocs, clearMs, destroyMs);
+}
+
+int main(int argc, char** argv) {
+    vector<size_t> sizes;
+    for (int i = 1; i < argc; i++) sizes.push_back(strtoul(argv[i], nullptr, 10));
+    if (sizes.empty()) {
+        sizes.push_back(1000000);
+        sizes.push_back(10000000);
+    }
+
+    printf("%-16s %10s %12s %14s %14s %10s %10s\n",
+           "allocator", "n", "insert ns", "new (insert)", "new (refill)", "clear ms", "destroy ms");
+
+    for (size_t n : sizes) {
+        vector<int> keys(n);
+        mt19937 rng(42);
+        for (size_t i = 0; i < n; i++) keys[i] = static_cast<int>(rng());
+
+        run<SkipList<int, int>>("std::allocator", keys);
+        run<SkipList<int, int, less<int>, SlabAllocator<pair<const int, int>>>>("SlabAllocator", keys);
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+// Benchmark de carga masiva: construir la lista con insert() en bucle frente a
+// from_sorted() (niveles aleatorios y balanceados), y mezclar un lote sin
+// ordenar con insert_batch() frente a insert() por elemento.
+//
+// Compilar (desde la raiz del repositorio):
+//   g++ -O2 -std=c++11 -I. -o bench_bulk_load benchmarks/bench_bulk_load.cpp
+//   ./bench_bulk_load [n1 n2 ...]      (por defecto 100000 1000000)
+
+#include "SkipList.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+typedef SkipList<int, int> List;
+
+static volatile int g_sink = 0;
+
+static void report(const char* op, size_t n, double ms, const List& sl) {
+    g_sink += static_cast<int>(sl.size());
+    printf("%-22s %10zu %10.2f %10.1f %6d\n", op, n, ms, ms * 1e6 / static_cast<double>(n), sl.maxLevel());
+}
+
+int main(int argc, char** argv) {
+    vector<size_t> sizes;
+    for (int i = 1; i < argc; i++) sizes.push_back(strtoul(argv[i], nullptr, 10));
+    if (sizes.empty()) {
+        sizes.push_back(100000);
+        sizes.push_back(1000000);
+    }
+
+    printf("%-22s %10s %10s %10s %6s\n", "operacion", "n", "ms", "ns/elem", "nivel");
+
+    for (size_t n : sizes) {
+        vector<pair<int, int>> sorted(n);
+        for (size_t i = 0; i < n; i++) sorted[i] = make_pair(static_cast<int>(2 * i), static_cast<int>(i));
+
+        {
+            List sl;
+            Clock::time_point t = Clock::now();
+            for (size_t i = 0; i < n; i++) sl.insert(sorted[i].first, sorted[i].second);
+            report("insert (ordenado)", n, msSince(t), sl);
+        }
+        {
+            Clock::time_point t = Clock::now();
+            List sl = List::from_sorted(sorted.begin(), sorted.end());
+            report("from_sorted", n, msSince(t), sl);
+        }
+        {
+            Clock::time_point t = Clock::now();
+            List sl = List::from_sorted(sorted.begin(), sorted.end(), true);
+            report("from_sorted balanced", n, msSince(t), sl);
+        }
+
+        // Lote de n/10 claves aleatorias (mitad presentes, mitad nuevas) sobre
+        // una lista de n elementos.
+        size_t m = n / 10;
+        vector<pair<int, int>> batch(m);
+        mt19937 rng(42);
+        for (size_t i = 0; i < m; i++) {
+            int k = static_cast<int>(rng() % (2 * n));
+            batch[i] = make_pair(k, k);
+        }
+        {
+            List sl = List::from_sorted(sorted.begin(), sorted.end());
+            Clock::time_point t = Clock::now();
+            for (size_t i = 0; i < m; i++) sl.insert(batch[i].first, batch[i].second);
+            report("insert (lote)", m, msSince(t), sl);
+        }
+        {
+            List sl = List::from_sorted(sorted.begin(), sorted.end());
+            Clock::time_point t = Clock::now();
+            sl.insert_batch(batch.begin(), batch.end());
+            report("insert_batch", m, msSince(t), sl);
+        }
+    }
+    return 0;
+}
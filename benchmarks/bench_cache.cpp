@@ -0,0 +1,138 @@
+// Benchmark de CacheSkipList: latencia de search (p50/p99/p99.9) y de cada
+// paso de la carga (insert + mantenimiento) mientras corre el desalojo.
+// Compara el desalojo por capacidad y el barrido de vencidos en pasos
+// acotados (expire_some(now, 4) en cada paso) con un barrido completo
+// periodico, que es lo que hace un hilo barrendero. El reloj de la cache es
+// falso y avanza 1 us por paso, asi que los vencimientos no dependen de la
+// maquina.
+//
+// Compilar (desde la raiz del repositorio):
+//   g++ -O2 -std=c++11 -I. -o bench_cache benchmarks/bench_cache.cpp
+//   ./bench_cache [n] [pasos]      (por defecto 200000 y 1000000)
+
+#include "CacheSkipList.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+struct BenchClock {
+    typedef chrono::microseconds duration;
+    typedef duration::rep rep;
+    typedef duration::period period;
+    typedef chrono::time_point<BenchClock> time_point;
+    static const bool is_steady = true;
+
+    static time_point& current() {
+        static time_point t;
+        return t;
+    }
+
+    static time_point now() {
+        return current();
+    }
+};
+
+typedef CacheSkipList<uint64_t, uint64_t, less<uint64_t>, BenchClock> Cache;
+
+struct Samples {
+    vector<double> lookup;
+    vector<double> step;
+};
+
+void report(const char* name, Samples& s, size_t removed) {
+    printf("%-30s %7.0f %7.0f %8.0f %9.0f %10.0f %9zu\n", name,
+           percentile(s.lookup, 50), percentile(s.lookup, 99), percentile(s.lookup, 99.9),
+           percentile(s.step, 99.9), percentile(s.step, 100), removed);
+}
+
+// Cada paso inserta una clave nueva (con TTL si ttlMax > 0), hace el
+// mantenimiento y mide un search de una clave viva.
+template <typename Maintain>
+void run(const char* name, Cache& cache, size_t n, size_t steps, uint64_t ttlMax, Maintain maintain) {
+    mt19937_64 rng(25);
+    Samples s;
+    s.lookup.reserve(steps);
+    s.step.reserve(steps);
+    uint64_t next = n;
+    uint64_t sink = 0;
+    size_t before = cache.evictions() + cache.expirations();
+    for (size_t i = 0; i < steps; i++) {
+        BenchClock::current() += chrono::microseconds(1);
+        Clock::time_point start = Clock::now();
+        if (ttlMax > 0) {
+            cache.insert(next, next, chrono::microseconds(1 + rng() % ttlMax));
+        } else {
+            cache.insert(next, next);
+        }
+        maintain(cache, i);
+        s.step.push_back(nsPerOp(start, 1));
+        next++;
+
+        uint64_t key = next - 1 - rng() % (n / 4);
+        uint64_t value = 0;
+        start = Clock::now();
+        cache.search(key, value);
+        s.lookup.push_back(nsPerOp(start, 1));
+        sink += value;
+    }
+    report(name, s, cache.evictions() + cache.expirations() - before);
+    if (sink == 1) printf("\n");
+}
+
+void fill(Cache& cache, size_t n, uint64_t ttlMax) {
+    mt19937_64 rng(7);
+    for (uint64_t k = 0; k < n; k++) {
+        if (ttlMax > 0) {
+            cache.insert(k, k, chrono::microseconds(1 + rng() % ttlMax));
+        } else {
+            cache.insert(k, k);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 200000;
+    size_t steps = argc > 2 ? strtoul(argv[2], nullptr, 10) : 1000000;
+    // Con TTL uniforme en [1, 2n] us y una insercion por us quedan ~n vivas
+    uint64_t ttlMax = 2 * n;
+
+    printf("n=%zu, %zu pasos; latencias en ns\n", n, steps);
+    printf("%-30s %7s %7s %8s %9s %10s %9s\n", "escenario", "p50", "p99", "p99.9", "paso p99.9", "paso max",
+           "borradas");
+
+    auto none = [](Cache&, size_t) {};
+    {
+        // Referencia: sin limite ni TTL la cache solo crece
+        Cache cache;
+        fill(cache, n, 0);
+        run("sin desalojo", cache, n, steps, 0, none);
+    }
+    for (int policy = 0; policy < 2; policy++) {
+        CacheOptions options;
+        options.maxSize = n;
+        options.policy = policy == 0 ? EVICT_LRU : EVICT_FIFO;
+        Cache cache(options);
+        fill(cache, n, 0);
+        run(policy == 0 ? "limite de tamano, LRU" : "limite de tamano, FIFO", cache, n, steps, 0, none);
+    }
+    {
+        Cache cache;
+        fill(cache, n, ttlMax);
+        run("TTL + expire_some(4) por paso", cache, n, steps, ttlMax, [](Cache& c, size_t) {
+            c.expire_some(BenchClock::now(), 4);
+        });
+    }
+    {
+        Cache cache;
+        fill(cache, n, ttlMax);
+        size_t period = n / 4;
+        run("TTL + barrido completo", cache, n, steps, ttlMax, [period](Cache& c, size_t i) {
+            if (i % period == 0) c.expire_some(BenchClock::now(), static_cast<size_t>(-1));
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Benchmark de busqueda con dedo: insert(key, value) frente a
+// insert(hint, key, value), y find(key) frente a find(hint, key), con claves
+// secuenciales, casi ordenadas (jitter pequeño) y aleatorias.
+//
+// Compilar (desde la raiz del repositorio):
+//   g++ -O2 -std=c++11 -I. -o bench_finger benchmarks/bench_finger.cpp
+//   ./bench_finger [n1 n2 ...]      (por defecto 100000 1000000)
+
+#include "SkipList.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+typedef SkipList<int, int> List;
+
+static volatile int g_sink = 0;
+
+static vector<int> makeKeys(const string& dist, size_t n) {
+    vector<int> keys(n);
+    mt19937 rng(42);
+    for (size_t i = 0; i < n; i++) {
+        int k = static_cast<int>(i) * 64;
+        if (dist == "nearly") k += static_cast<int>(rng() % 257) - 128;  // ~4 posiciones
+        keys[i] = k;
+    }
+    if (dist == "random") shuffle(keys.begin(), keys.end(), rng);
+    return keys;
+}
+
+static void run(const string& dist, size_t n) {
+    vector<int> keys = makeKeys(dist, n);
+
+    List plain;
+    Clock::time_point t = Clock::now();
+    for (size_t i = 0; i < n; i++) plain.insert(keys[i], keys[i]);
+    double insertNs = nsPerOp(t, n);
+
+    List hinted;
+    List::Iterator it = hinted.end();
+    t = Clock::now();
+    for (size_t i = 0; i < n; i++) it = hinted.insert(it, keys[i], keys[i]);
+    double hintNs = nsPerOp(t, n);
+
+    t = Clock::now();
+    for (size_t i = 0; i < n; i++) g_sink += plain.find(keys[i]) != plain.end();
+    double findNs = nsPerOp(t, n);
+
+    it = hinted.begin();
+    t = Clock::now();
+    for (size_t i = 0; i < n; i++) {
+        it = hinted.find(it, keys[i]);
+        g_sink += it != hinted.end();
+    }
+    double findHintNs = nsPerOp(t, n);
+
+    printf("%-11s %10zu %12.1f %12.1f %12.1f %12.1f\n",
+           dist.c_str(), n, insertNs, hintNs, findNs, findHintNs);
+}
+
+int main(int argc, char** argv) {
+    vector<size_t> sizes;
+    for (int i = 1; i < argc; i++) sizes.push_back(strtoul(argv[i], nullptr, 10));
+    if (sizes.empty()) {
+        sizes.push_back(100000);
+        sizes.push_back(1000000);
+    }
+
+    printf("%-11s %10s %12s %12s %12s %12s\n",
+           "claves", "n", "insert ns", "insert+hint", "find ns", "find+hint");
+
+    const char* dists[] = { "sequential", "nearly", "random" };
+    for (size_t n : sizes) {
+        for (size_t d = 0; d < sizeof(dists) / sizeof(dists[0]); d++) run(dists[d], n);
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+// Benchmark de generadores de niveles: MersenneLevelGenerator (el original,
+// mt19937 y un float por nivel) frente a GeometricLevelGenerator (xorshift64*
+// con una extraccion y ceros finales, o un logaritmo si p no es 1/2^k), y
+// AUTO_LEVEL. Mide el costo del generador solo, la insercion de n claves
+// aleatorias, la memoria de los nodos y el tamaño de cada lista vacia.
+//
+// Compilar (desde la raiz del repositorio):
+//   g++ -O2 -std=c++11 -I. -o bench_levels benchmarks/bench_levels.cpp
+//   ./bench_levels [n]      (por defecto 1000000)
+
+#include "SkipList.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+
+typedef allocator<pair<const int64_t, int64_t> > Alloc;
+typedef SkipList<int64_t, int64_t, less<int64_t>, Alloc, MersenneLevelGenerator> MersenneList;
+typedef SkipList<int64_t, int64_t, less<int64_t>, Alloc, GeometricLevelGenerator> GeometricList;
+
+static volatile int64_t g_sink = 0;
+
+template <typename Gen>
+double drawCost(float p, size_t draws) {
+    Gen gen(p, 12345);
+    int64_t sum = 0;
+    Clock::time_point t = Clock::now();
+    for (size_t i = 0; i < draws; i++) sum += gen(16);
+    g_sink += sum;
+    return nsPerOp(t, draws);
+}
+
+template <typename List>
+void run(const char* name, int maxLevel, float p, const vector<int64_t>& keys) {
+    List sl(maxLevel, p);
+    sl.seed(2024);
+    Clock::time_point t = Clock::now();
+    for (size_t i = 0; i < keys.size(); i++) sl.insert(keys[i], keys[i]);
+    double insertNs = nsPerOp(t, keys.size());
+    SkipListStats st = sl.stats();
+    printf("%-22s %5.2f %10.1f %9d %12.1f %10zu\n", name, p, insertNs, sl.maxLevel(),
+           static_cast<double>(st.totalBytes) / (1024.0 * 1024.0), sizeof(List));
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+    vector<int64_t> keys(n);
+    mt19937_64 rng(7);
+    for (size_t i = 0; i < n; i++) keys[i] = static_cast<int64_t>(rng() >> 1);
+
+    printf("costo del generador (ns por llamada)\n");
+    const float probs[] = { 0.5f, 0.25f, 0.3f };
+    for (size_t i = 0; i < 3; i++) {
+        printf("  p=%.2f  Mersenne %6.2f   Geometric %6.2f\n", probs[i],
+               drawCost<MersenneLevelGenerator>(probs[i], 10000000),
+               drawCost<GeometricLevelGenerator>(probs[i], 10000000));
+    }
+
+    printf("\nn = %zu\n", n);
+    printf("%-22s %5s %10s %9s %12s %10s\n", "generador", "p", "insert ns", "maxLevel", "nodos MB", "sizeof");
+    for (size_t i = 0; i < 3; i++) {
+        run<MersenneList>("Mersenne", 16, probs[i], keys);
+        run<GeometricList>("Geometric", 16, probs[i], keys);
+        run<GeometricList>("Geometric AUTO_LEVEL", GeometricList::AUTO_LEVEL, probs[i], keys);
+    }
+    return 0;
+}
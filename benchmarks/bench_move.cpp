@@ -0,0 +1,80 @@
+// Benchmark de valores grandes: insert copiando frente a insert moviendo un
+// buffer, y traspaso de la mitad de las entradas a otra lista con
+// at + insert + remove frente a extract + insert(handle). Reporta ns/op y
+// llamadas a operator new por entrada.
+//
+// Compilar (desde la raiz del repositorio):
+//   g++ -O2 -std=c++11 -I. -o bench_move benchmarks/bench_move.cpp
+//   ./bench_move [n] [bytesPorValor]     (por defecto 100000 4096)
+
+#define BENCH_COUNT_ALLOCATIONS
+
+#include "SkipList.h"
+#include "bench_util.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+typedef vector<char> Buffer;
+typedef SkipList<int, Buffer> List;
+
+void report(const char* name, Clock::time_point start, size_t allocs, size_t n) {
+    double ns = nsPerOp(start, n);
+    printf("%-28s %10.1f %12.2f\n", name, ns, double(g_allocations - allocs) / double(n));
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+    size_t bytes = argc > 2 ? strtoul(argv[2], nullptr, 10) : 4096;
+
+    vector<int> keys(n);
+    for (size_t i = 0; i < n; i++) keys[i] = static_cast<int>(i);
+    shuffle(keys.begin(), keys.end(), mt19937(42));
+
+    printf("n=%zu valor=%zu bytes\n", n, bytes);
+    printf("%-28s %10s %12s\n", "operacion", "ns/op", "allocs/op");
+
+    List copied;
+    size_t allocs = g_allocations;
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < n; i++) {
+        Buffer buffer(bytes, static_cast<char>(i));
+        copied.insert(keys[i], buffer);
+    }
+    report("insert(const V&)", start, allocs, n);
+
+    List moved;
+    allocs = g_allocations;
+    start = Clock::now();
+    for (size_t i = 0; i < n; i++) {
+        Buffer buffer(bytes, static_cast<char>(i));
+        moved.insert(keys[i], std::move(buffer));
+    }
+    report("insert(V&&)", start, allocs, n);
+
+    size_t half = n / 2;
+    List target;
+    allocs = g_allocations;
+    start = Clock::now();
+    for (size_t i = 0; i < half; i++) {
+        target.insert(keys[i], copied.at(keys[i]));
+        copied.remove(keys[i]);
+    }
+    report("at + insert + remove", start, allocs, half);
+
+    List handles;
+    allocs = g_allocations;
+    start = Clock::now();
+    for (size_t i = 0; i < half; i++) {
+        handles.insert(moved.extract(keys[i]));
+    }
+    report("extract + insert(handle)", start, allocs, half);
+
+    if (target.size() != handles.size()) printf("tamaños distintos\n");
+    return 0;
+}
@@ -0,0 +1,97 @@
+// Benchmark de busqueda por lotes: un bucle de contains() frente a
+// contains_batch() con lotes desordenados (descensos intercalados con
+// prefetch), ordenados y de claves contiguas (donde se usa el dedo entre
+// claves consecutivas).
+//
+// Compilar (desde la raiz del repositorio):
+//   g++ -O2 -std=c++11 -I. -o bench_multi_find benchmarks/bench_multi_find.cpp
+//   ./bench_multi_find [n] [lote]      (por defecto 1000000 y 64)
+
+#include "SkipList.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+
+static volatile size_t g_sink = 0;
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+    size_t batch = argc > 2 ? strtoul(argv[2], nullptr, 10) : 64;
+    size_t lookups = 2000000 / batch * batch;
+
+    SkipList<int, int> sl;
+    vector<int> keys(n);
+    mt19937 rng(42);
+    for (size_t i = 0; i < n; i++) {
+        keys[i] = static_cast<int>(rng());
+        sl.insert(keys[i], keys[i]);
+    }
+
+    // Mitad aciertos, mitad fallos
+    vector<int> probes(lookups);
+    for (size_t i = 0; i < lookups; i++) {
+        probes[i] = i % 2 ? keys[rng() % n] : static_cast<int>(rng());
+    }
+    vector<int> sortedProbes(probes);
+    for (size_t b = 0; b < lookups; b += batch) {
+        sort(sortedProbes.begin() + b, sortedProbes.begin() + b + batch);
+    }
+
+    // Lotes de claves contiguas en la lista: el caso del dedo
+    vector<int> contiguous(lookups);
+    {
+        vector<int> sortedKeys(keys);
+        sort(sortedKeys.begin(), sortedKeys.end());
+        for (size_t b = 0; b < lookups; b += batch) {
+            size_t start = rng() % (n - batch);
+            for (size_t i = 0; i < batch; i++) contiguous[b + i] = sortedKeys[start + i];
+        }
+    }
+
+    printf("n = %zu, lote = %zu, %zu busquedas\n", n, batch, lookups);
+    printf("%-28s %10s\n", "variante", "ns/clave");
+
+    Clock::time_point t = Clock::now();
+    size_t found = 0;
+    for (size_t i = 0; i < lookups; i++) found += sl.contains(probes[i]);
+    printf("%-28s %10.1f\n", "contains en bucle", nsPerOp(t, lookups));
+
+    vector<bool> out;
+    out.reserve(batch);
+    t = Clock::now();
+    for (size_t b = 0; b < lookups; b += batch) {
+        out.clear();
+        found += sl.contains_batch(probes.begin() + b, probes.begin() + b + batch, back_inserter(out));
+    }
+    printf("%-28s %10.1f\n", "contains_batch", nsPerOp(t, lookups));
+
+    t = Clock::now();
+    for (size_t i = 0; i < lookups; i++) found += sl.contains(sortedProbes[i]);
+    printf("%-28s %10.1f\n", "contains en bucle (ordenado)", nsPerOp(t, lookups));
+
+    t = Clock::now();
+    for (size_t b = 0; b < lookups; b += batch) {
+        out.clear();
+        found += sl.contains_batch(sortedProbes.begin() + b, sortedProbes.begin() + b + batch,
+                                   back_inserter(out));
+    }
+    printf("%-28s %10.1f\n", "contains_batch (ordenado)", nsPerOp(t, lookups));
+
+    t = Clock::now();
+    for (size_t i = 0; i < lookups; i++) found += sl.contains(contiguous[i]);
+    printf("%-28s %10.1f\n", "contains en bucle (contiguo)", nsPerOp(t, lookups));
+
+    t = Clock::now();
+    for (size_t b = 0; b < lookups; b += batch) {
+        out.clear();
+        found += sl.contains_batch(contiguous.begin() + b, contiguous.begin() + b + batch,
+                                   back_inserter(out));
+    }
+    printf("%-28s %10.1f\n", "contains_batch (contiguo)", nsPerOp(t, lookups));
+
+    g_sink += found;
+    return 0;
+}
@@ -0,0 +1,71 @@
+// Benchmark del layout de nodos: insercion, busqueda, recorrido, copia y
+// destruccion, contando ademas las llamadas a operator new.
+//
+// Compilar (desde la raiz del repositorio):
+//   g++ -O2 -std=c++11 -I. -o bench_node_layout benchmarks/bench_node_layout.cpp
+//   ./bench_node_layout [n]
+
+#define BENCH_COUNT_ALLOCATIONS
+
+#include "SkipList.h"
+#include "bench_util.h"
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+
+    vector<int> keys(n);
+    iota(keys.begin(), keys.end(), 0);
+    mt19937 rng(42);
+    shuffle(keys.begin(), keys.end(), rng);
+    vector<int> probes(keys);
+    shuffle(probes.begin(), probes.end(), rng);
+
+    printf("n = %zu\n", n);
+    printf("%-12s %12s %14s\n", "operacion", "ns/op", "allocs/elem");
+
+    {
+        SkipList<int, int>* sl = new SkipList<int, int>();
+
+        size_t allocs = g_allocations;
+        Clock::time_point t = Clock::now();
+        for (int k : keys) sl->insert(k, k);
+        printf("%-12s %12.1f %14.2f\n", "insert", nsPerOp(t, n),
+               double(g_allocations - allocs) / double(n));
+
+        long long sum = 0;
+        t = Clock::now();
+        for (int k : probes) {
+            int v;
+            if (sl->search(k, v)) sum += v;
+        }
+        printf("%-12s %12.1f %14s\n", "search", nsPerOp(t, n), "-");
+
+        t = Clock::now();
+        for (auto it = sl->begin(); it != sl->end(); ++it) sum += it.value();
+        printf("%-12s %12.1f %14s\n", "iterate", nsPerOp(t, n), "-");
+
+        allocs = g_allocations;
+        t = Clock::now();
+        SkipList<int, int>* copy = new SkipList<int, int>(*sl);
+        printf("%-12s %12.1f %14.2f\n", "copy", nsPerOp(t, n),
+               double(g_allocations - allocs) / double(n));
+
+        t = Clock::now();
+        for (size_t i = 0; i < n / 2; i++) copy->remove(probes[i]);
+        printf("%-12s %12.1f %14s\n", "remove", nsPerOp(t, n / 2), "-");
+
+        t = Clock::now();
+        delete sl;
+        printf("%-12s %12.1f %14s\n", "destroy", nsPerOp(t, n), "-");
+        delete copy;
+
+        if (sum == 42) printf("\n");
+    }
+    return 0;
+}
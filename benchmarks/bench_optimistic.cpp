@@ -0,0 +1,121 @@
+// Benchmark de lecturas concurrentes: OptimisticSkipList (lecturas sin locks,
+// escrituras con mutex) frente a un SkipList protegido por un shared_mutex
+// (lecturas con lock compartido), escalando de 1 a N hilos con una mezcla de
+// lecturas y escrituras.
+//
+// Compilar (desde la raiz del repositorio):
+//   g++ -O2 -std=c++17 -pthread -I. -o bench_optimistic benchmarks/bench_optimistic.cpp
+//   ./bench_optimistic [maxThreads] [opsPorHilo] [lecturas%]
+// Con C++14 se usa shared_timed_mutex.
+
+#include "SkipList.h"
+#include "OptimisticSkipList.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+#if __cplusplus >= 201703L
+typedef shared_mutex SharedMutex;
+#else
+typedef shared_timed_mutex SharedMutex;
+#endif
+
+static const int KEY_RANGE = 1 << 20;
+
+class SharedMutexSkipList {
+private:
+    SkipList<int, int> list_;
+    mutable SharedMutex mutex_;
+
+public:
+    bool insert(int key, int value) {
+        unique_lock<SharedMutex> lock(mutex_);
+        return list_.insert(key, value);
+    }
+
+    bool remove(int key) {
+        unique_lock<SharedMutex> lock(mutex_);
+        return list_.remove(key);
+    }
+
+    bool contains(int key) const {
+        shared_lock<SharedMutex> lock(mutex_);
+        return list_.contains(key);
+    }
+};
+
+// Devuelve Mops/s totales y, en readMops, solo las lecturas
+template <typename List>
+double run(List& list, int threads, size_t opsPerThread, int readPercent, double& readMops) {
+    vector<thread> workers;
+    vector<size_t> reads(static_cast<size_t>(threads), 0);
+    Clock::time_point start = Clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(thread([&list, &reads, t, opsPerThread, readPercent]() {
+            mt19937 rng(1234 + t);
+            size_t hits = 0;
+            size_t done = 0;
+            for (size_t i = 0; i < opsPerThread; i++) {
+                int key = static_cast<int>(rng() % KEY_RANGE);
+                int op = static_cast<int>(rng() % 100);
+                if (op < readPercent) {
+                    hits += list.contains(key);
+                    done++;
+                } else if (op % 2 == 0) {
+                    list.insert(key, key);
+                } else {
+                    list.remove(key);
+                }
+            }
+            reads[static_cast<size_t>(t)] = done;
+            if (hits == static_cast<size_t>(-1)) printf("\n");
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); t++) workers[t].join();
+    double seconds = msSince(start) / 1000.0;
+    size_t totalReads = 0;
+    for (size_t t = 0; t < reads.size(); t++) totalReads += reads[t];
+    readMops = static_cast<double>(totalReads) / seconds / 1e6;
+    return static_cast<double>(threads) * static_cast<double>(opsPerThread) / seconds / 1e6;
+}
+
+template <typename List>
+void prefill(List& list) {
+    mt19937 rng(7);
+    for (int i = 0; i < KEY_RANGE / 2; i++) {
+        int key = static_cast<int>(rng() % KEY_RANGE);
+        list.insert(key, key);
+    }
+}
+
+int main(int argc, char** argv) {
+    int maxThreads = argc > 1 ? atoi(argv[1]) : static_cast<int>(thread::hardware_concurrency());
+    size_t opsPerThread = argc > 2 ? strtoul(argv[2], nullptr, 10) : 500000;
+    int readPercent = argc > 3 ? atoi(argv[3]) : 95;
+    if (maxThreads < 1) maxThreads = 1;
+
+    printf("ops/hilo=%zu lecturas=%d%% claves=%d\n", opsPerThread, readPercent, KEY_RANGE);
+    printf("%8s %16s %16s %16s %16s\n", "hilos", "shared Mops/s", "shared lect.", "optimista Mops/s", "optimista lect.");
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double sharedReads = 0.0;
+        SharedMutexSkipList shared;
+        prefill(shared);
+        double sharedMops = run(shared, threads, opsPerThread, readPercent, sharedReads);
+
+        double optimisticReads = 0.0;
+        OptimisticSkipList<int, int> optimistic;
+        prefill(optimistic);
+        double optimisticMops = run(optimistic, threads, opsPerThread, readPercent, optimisticReads);
+
+        printf("%8d %16.2f %16.2f %16.2f %16.2f\n", threads, sharedMops, sharedReads, optimisticMops, optimisticReads);
+        if (threads < maxThreads && threads * 2 > maxThreads) threads = maxThreads / 2;
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Benchmark de las variantes paralelas: copia (constructor normal frente a
+// SkipList(other, threads)), construccion desde una entrada ordenada
+// (from_sorted frente a parallel_from_sorted) y suma de un rango con
+// parallel_reduce. Reporta ms y aceleracion respecto de un hilo.
+//
+// Compilar (desde la raiz del repositorio):
+//   g++ -O2 -std=c++11 -pthread -I. -o bench_parallel benchmarks/bench_parallel.cpp
+//   ./bench_parallel [n] [hilos max]      (por defecto 2000000 y hardware_concurrency)
+
+#include "SkipList.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+typedef SkipList<long long, long long> List;
+
+void row(const char* name, unsigned threads, double ms, double base) {
+    printf("%-26s %6u %10.2f %8.2fx\n", name, threads, ms, base / ms);
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 2000000;
+    unsigned maxThreads = argc > 2 ? static_cast<unsigned>(atoi(argv[2])) : thread::hardware_concurrency();
+    if (maxThreads == 0) maxThreads = 1;
+
+    mt19937_64 rng(24);
+    vector<pair<long long, long long>> entries;
+    entries.reserve(n);
+    long long key = 0;
+    for (size_t i = 0; i < n; i++) {
+        key += 1 + static_cast<long long>(rng() % 8);
+        entries.push_back(make_pair(key, key));
+    }
+    List source = List::from_sorted(entries.begin(), entries.end());
+    long long lo = entries[n / 10].first;
+    long long hi = entries[n - n / 10].first;
+
+    printf("n=%zu, %u hilos de hardware\n", n, thread::hardware_concurrency());
+    printf("%-26s %6s %10s %9s\n", "operacion", "hilos", "ms", "acel");
+
+    double copyBase;
+    {
+        Clock::time_point start = Clock::now();
+        List copy(source);
+        copyBase = msSince(start);
+        row("copia (constructor)", 1, copyBase, copyBase);
+    }
+    for (unsigned t = 2; t <= maxThreads; t *= 2) {
+        Clock::time_point start = Clock::now();
+        List copy(source, t);
+        row("copia paralela", t, msSince(start), copyBase);
+    }
+
+    double buildBase;
+    {
+        Clock::time_point start = Clock::now();
+        List built = List::from_sorted(entries.begin(), entries.end());
+        buildBase = msSince(start);
+        row("from_sorted", 1, buildBase, buildBase);
+    }
+    for (unsigned t = 2; t <= maxThreads; t *= 2) {
+        Clock::time_point start = Clock::now();
+        List built = List::parallel_from_sorted(entries.begin(), entries.end(), false, 16, 0.5f, t);
+        row("parallel_from_sorted", t, msSince(start), buildBase);
+    }
+
+    auto value = [](const long long&, const long long& v) { return v; };
+    auto sum = [](long long a, long long b) { return a + b; };
+    double reduceBase = 0.0;
+    long long expected = 0;
+    for (unsigned t = 1; t <= maxThreads; t *= 2) {
+        Clock::time_point start = Clock::now();
+        long long total = source.parallel_reduce(lo, hi, 0LL, value, sum, t);
+        double ms = msSince(start);
+        if (t == 1) {
+            reduceBase = ms;
+            expected = total;
+        } else if (total != expected) {
+            printf("ERROR: suma distinta con %u hilos\n", t);
+            return 1;
+        }
+        row("parallel_reduce (80%)", t, ms, reduceBase);
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Benchmark de arranque en frio: reconstruir la lista reinsertando cada
+// entrada (lo que habia que hacer sin persistencia) frente a load(), que
+// reconstruye en O(n) con las alturas guardadas, y frente a abrir el archivo
+// con MappedSkipList, que no deserializa nada. Tambien mide save() y las
+// busquedas sobre la lista y sobre el mapeo.
+//
+// El archivo queda en la cache de paginas despues de save(), asi que los
+// tiempos de load y de mmap son con cache caliente; para medir con disco
+// frio, vaciar la cache (echo 3 > /proc/sys/vm/drop_caches) antes de cada
+// corrida con un archivo ya guardado.
+//
+// Compilar (desde la raiz del repositorio):
+//   g++ -O2 -std=c++11 -I. -o bench_persistence benchmarks/bench_persistence.cpp
+//   ./bench_persistence [n] [archivo]      (por defecto 10000000 y bench_skiplist.bin)
+
+#include "SkipList.h"
+#include "MappedSkipList.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+typedef SkipList<int64_t, int64_t> List;
+
+static volatile int64_t g_sink = 0;
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 10000000;
+    string path = argc > 2 ? argv[2] : "bench_skiplist.bin";
+
+    vector<int64_t> keys(n);
+    mt19937_64 rng(42);
+    for (size_t i = 0; i < n; i++) keys[i] = static_cast<int64_t>(rng() >> 1);
+    vector<int64_t> probes(1000000);
+    for (size_t i = 0; i < probes.size(); i++) probes[i] = keys[rng() % n];
+
+    printf("n = %zu\n", n);
+    printf("%-32s %12s\n", "operacion", "ms");
+
+    List* sl = new List();
+    Clock::time_point t = Clock::now();
+    for (size_t i = 0; i < n; i++) sl->insert(keys[i], keys[i]);
+    printf("%-32s %12.1f\n", "reinsertar n entradas", msSince(t));
+
+    t = Clock::now();
+    sl->save(path);
+    printf("%-32s %12.1f\n", "save()", msSince(t));
+    delete sl;
+
+    List* loaded = new List();
+    t = Clock::now();
+    loaded->load(path);
+    printf("%-32s %12.1f\n", "load() (checksum + O(n))", msSince(t));
+
+    t = Clock::now();
+    int64_t sum = 0;
+    for (size_t i = 0; i < probes.size(); i++) {
+        int64_t v;
+        if (loaded->search(probes[i], v)) sum += v;
+    }
+    double listLookup = nsPerOp(t, probes.size());
+    delete loaded;
+
+    t = Clock::now();
+    {
+        MappedSkipList<int64_t, int64_t> mapped(path);
+        int64_t v;
+        mapped.search(probes[0], v);
+        printf("%-32s %12.3f\n", "mmap + primera busqueda", msSince(t));
+
+        t = Clock::now();
+        mapped.verify();
+        printf("%-32s %12.1f\n", "verify() del mapeo", msSince(t));
+
+        t = Clock::now();
+        for (size_t i = 0; i < probes.size(); i++) {
+            if (mapped.search(probes[i], v)) sum += v;
+        }
+        double mappedLookup = nsPerOp(t, probes.size());
+        printf("\n%-32s %12.1f\n", "busqueda SkipList (ns)", listLookup);
+        printf("%-32s %12.1f\n", "busqueda MappedSkipList (ns)", mappedLookup);
+    }
+    g_sink += sum;
+    printf("pico de RSS: %.1f MB\n", peakRssMB());
+    remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,217 @@
+// Benchmark de cola de prioridad / scheduler de timers:
+//   1. modelo "hold": sacar el minimo y reprogramarlo mas adelante, con
+//      std::priority_queue, std::multimap, SkipList con begin() + remove() y
+//      SkipList con pop_front();
+//   2. vaciado por lotes de los timers vencidos: bucle de pops frente a
+//      pop_until();
+//   3. varios consumidores: ConcurrentSkipList::pop_front frente a un
+//      std::priority_queue con mutex (-pthread).
+// Las claves son (instante << 22) | secuencia, para que sean unicas.
+//
+// Compilar (desde la raiz del repositorio):
+//   g++ -O2 -std=c++11 -pthread -I. -o bench_scheduler benchmarks/bench_scheduler.cpp
+//   ./bench_scheduler [n] [maxThreads]     (por defecto 1000000 y hardware_concurrency)
+
+#include "SkipList.h"
+#include "ConcurrentSkipList.h"
+#include "bench_util.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+typedef pair<uint64_t, uint64_t> Timer;
+typedef priority_queue<Timer, vector<Timer>, greater<Timer>> MinHeap;
+
+static const uint64_t SEQ_BITS = 22;
+
+struct KeyGen {
+    mt19937_64 rng;
+    uint64_t seq;
+
+    KeyGen() : rng(42), seq(0) {}
+
+    uint64_t at(uint64_t time) {
+        return (time << SEQ_BITS) | (seq++ & ((uint64_t(1) << SEQ_BITS) - 1));
+    }
+
+    uint64_t delay() {
+        return 1 + rng() % 1000;
+    }
+};
+
+// Adaptadores con la misma interfaz: push, pop_min(key, value), size
+struct HeapQueue {
+    MinHeap heap;
+    void push(uint64_t key, uint64_t value) { heap.push(Timer(key, value)); }
+    bool pop_min(uint64_t& key, uint64_t& value) {
+        if (heap.empty()) return false;
+        key = heap.top().first;
+        value = heap.top().second;
+        heap.pop();
+        return true;
+    }
+};
+
+struct MultimapQueue {
+    multimap<uint64_t, uint64_t> map;
+    void push(uint64_t key, uint64_t value) { map.insert(make_pair(key, value)); }
+    bool pop_min(uint64_t& key, uint64_t& value) {
+        if (map.empty()) return false;
+        key = map.begin()->first;
+        value = map.begin()->second;
+        map.erase(map.begin());
+        return true;
+    }
+};
+
+struct RemoveQueue {
+    SkipList<uint64_t, uint64_t> list;
+    void push(uint64_t key, uint64_t value) { list.insert(key, value); }
+    bool pop_min(uint64_t& key, uint64_t& value) {
+        SkipList<uint64_t, uint64_t>::Iterator first = list.begin();
+        if (first == list.end()) return false;
+        key = first.key();
+        value = first.value();
+        list.remove(key);
+        return true;
+    }
+};
+
+struct PopFrontQueue {
+    SkipList<uint64_t, uint64_t> list;
+    void push(uint64_t key, uint64_t value) { list.insert(key, value); }
+    bool pop_min(uint64_t& key, uint64_t& value) { return list.pop_front(key, value); }
+};
+
+template <typename Queue>
+void hold(const char* name, size_t n) {
+    Queue queue;
+    KeyGen gen;
+    for (size_t i = 0; i < n; i++) queue.push(gen.at(gen.delay()), i);
+
+    Clock::time_point start = Clock::now();
+    uint64_t key = 0, value = 0, checksum = 0;
+    for (size_t i = 0; i < n; i++) {
+        queue.pop_min(key, value);
+        checksum += value;
+        queue.push(gen.at((key >> SEQ_BITS) + gen.delay()), value);
+    }
+    printf("%-28s %10.1f\n", name, nsPerOp(start, n));
+    if (checksum == 1) printf("\n");
+}
+
+// Vacia los vencidos avanzando el reloj de a step; ns por timer quitado
+template <typename Queue>
+void drainLoop(const char* name, size_t n, uint64_t step) {
+    Queue queue;
+    KeyGen gen;
+    for (size_t i = 0; i < n; i++) queue.push(gen.at(gen.rng() % 100000), i);
+
+    Clock::time_point start = Clock::now();
+    size_t drained = 0;
+    uint64_t key, value;
+    for (uint64_t now = step; drained < n; now += step) {
+        uint64_t limit = ((now + 1) << SEQ_BITS) - 1;
+        while (queue.pop_min(key, value)) {
+            if (key > limit) {
+                queue.push(key, value);
+                break;
+            }
+            drained++;
+        }
+    }
+    printf("%-28s %10.1f\n", name, nsPerOp(start, n));
+}
+
+void drainPopUntil(size_t n, uint64_t step) {
+    SkipList<uint64_t, uint64_t> list;
+    KeyGen gen;
+    for (size_t i = 0; i < n; i++) list.insert(gen.at(gen.rng() % 100000), i);
+
+    vector<pair<uint64_t, uint64_t>> due;
+    Clock::time_point start = Clock::now();
+    size_t drained = 0;
+    for (uint64_t now = step; drained < n; now += step) {
+        due.clear();
+        drained += list.pop_until(((now + 1) << SEQ_BITS) - 1, back_inserter(due));
+    }
+    printf("%-28s %10.1f\n", "SkipList pop_until", nsPerOp(start, n));
+}
+
+struct LockedHeap {
+    MinHeap heap;
+    mutex lock;
+    void push(uint64_t key, uint64_t value) { heap.push(Timer(key, value)); }
+    bool pop_front(uint64_t& key, uint64_t& value) {
+        lock_guard<mutex> guard(lock);
+        if (heap.empty()) return false;
+        key = heap.top().first;
+        value = heap.top().second;
+        heap.pop();
+        return true;
+    }
+};
+
+struct ConcurrentQueue {
+    ConcurrentSkipList<uint64_t, uint64_t> list;
+    void push(uint64_t key, uint64_t value) { list.insert(key, value); }
+    bool pop_front(uint64_t& key, uint64_t& value) { return list.pop_front(key, value); }
+};
+
+// Mops/s vaciando n timers con threads consumidores
+template <typename Queue>
+double consume(size_t n, int threads) {
+    Queue queue;
+    KeyGen gen;
+    for (size_t i = 0; i < n; i++) queue.push(gen.at(gen.rng() % 100000), i);
+
+    vector<thread> workers;
+    Clock::time_point start = Clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(thread([&queue]() {
+            uint64_t key, value, checksum = 0;
+            while (queue.pop_front(key, value)) checksum += value;
+            if (checksum == 1) printf("\n");
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); t++) workers[t].join();
+    return static_cast<double>(n) / (msSince(start) / 1000.0) / 1e6;
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+    int maxThreads = argc > 2 ? atoi(argv[2]) : static_cast<int>(thread::hardware_concurrency());
+    if (maxThreads < 1) maxThreads = 1;
+
+    printf("n=%zu\n\n%-28s %10s\n", n, "hold (pop + push)", "ns/op");
+    hold<HeapQueue>("std::priority_queue", n);
+    hold<MultimapQueue>("std::multimap", n);
+    hold<RemoveQueue>("SkipList begin + remove", n);
+    hold<PopFrontQueue>("SkipList pop_front", n);
+
+    printf("\n%-28s %10s\n", "vaciado por lotes", "ns/timer");
+    drainLoop<HeapQueue>("std::priority_queue", n, 100);
+    drainLoop<MultimapQueue>("std::multimap", n, 100);
+    drainLoop<RemoveQueue>("SkipList begin + remove", n, 100);
+    drainLoop<PopFrontQueue>("SkipList pop_front", n, 100);
+    drainPopUntil(n, 100);
+
+    printf("\n%8s %18s %18s\n", "hilos", "heap+mutex Mops/s", "concurrente Mops/s");
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double locked = consume<LockedHeap>(n, threads);
+        double concurrent = consume<ConcurrentQueue>(n, threads);
+        printf("%8d %18.2f %18.2f\n", threads, locked, concurrent);
+        if (threads < maxThreads && threads * 2 > maxThreads) threads = maxThreads / 2;
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Benchmark de ShardedSkipList: throughput con escrituras frente a un SkipList
+// protegido por un unico mutex, escalando de 1 a N hilos. Se mide el reparto
+// por rangos (con rebalanceo automatico) y por hash.
+//
+// Compilar (desde la raiz del repositorio):
+//   g++ -O2 -std=c++11 -pthread -I. -o bench_sharded benchmarks/bench_sharded.cpp
+//   ./bench_sharded [maxThreads] [opsPorHilo] [lecturas%] [shards]
+
+#include "SkipList.h"
+#include "ShardedSkipList.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+static const int KEY_RANGE = 1 << 20;
+
+class MutexSkipList {
+private:
+    SkipList<int, int> list_;
+    mutable mutex mutex_;
+
+public:
+    bool insert(int key, int value) {
+        lock_guard<mutex> lock(mutex_);
+        return list_.insert(key, value);
+    }
+
+    bool remove(int key) {
+        lock_guard<mutex> lock(mutex_);
+        return list_.remove(key);
+    }
+
+    bool contains(int key) const {
+        lock_guard<mutex> lock(mutex_);
+        return list_.contains(key);
+    }
+};
+
+template <typename List>
+double run(List& list, int threads, size_t opsPerThread, int readPercent) {
+    vector<thread> workers;
+    Clock::time_point start = Clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(thread([&list, t, opsPerThread, readPercent]() {
+            mt19937 rng(1234 + t);
+            size_t hits = 0;
+            for (size_t i = 0; i < opsPerThread; i++) {
+                int key = static_cast<int>(rng() % KEY_RANGE);
+                int op = static_cast<int>(rng() % 100);
+                if (op < readPercent) {
+                    hits += list.contains(key);
+                } else if (op % 2 == 0) {
+                    list.insert(key, key);
+                } else {
+                    list.remove(key);
+                }
+            }
+            if (hits == static_cast<size_t>(-1)) printf("\n");
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); t++) workers[t].join();
+    double seconds = msSince(start) / 1000.0;
+    return static_cast<double>(threads) * static_cast<double>(opsPerThread) / seconds / 1e6;
+}
+
+template <typename List>
+void prefill(List& list) {
+    mt19937 rng(7);
+    for (int i = 0; i < KEY_RANGE / 2; i++) {
+        int key = static_cast<int>(rng() % KEY_RANGE);
+        list.insert(key, key);
+    }
+}
+
+int main(int argc, char** argv) {
+    int maxThreads = argc > 1 ? atoi(argv[1]) : static_cast<int>(thread::hardware_concurrency());
+    size_t opsPerThread = argc > 2 ? strtoul(argv[2], nullptr, 10) : 500000;
+    int readPercent = argc > 3 ? atoi(argv[3]) : 50;
+    size_t shards = argc > 4 ? strtoul(argv[4], nullptr, 10) : 16;
+    if (maxThreads < 1) maxThreads = 1;
+
+    printf("ops/hilo=%zu lecturas=%d%% claves=%d shards=%zu\n", opsPerThread, readPercent, KEY_RANGE, shards);
+    printf("%8s %14s %14s %8s %14s\n", "hilos", "mutex Mops/s", "rangos Mops/s", "shards", "hash Mops/s");
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        MutexSkipList locked;
+        prefill(locked);
+        double lockedMops = run(locked, threads, opsPerThread, readPercent);
+
+        ShardedSkipList<int, int> byRange(shards);
+        prefill(byRange);
+        double rangeMops = run(byRange, threads, opsPerThread, readPercent);
+
+        ShardedSkipList<int, int, less<int>, hash<int>> byHash(shards);
+        prefill(byHash);
+        double hashMops = run(byHash, threads, opsPerThread, readPercent);
+
+        printf("%8d %14.2f %14.2f %8zu %14.2f\n", threads, lockedMops, rangeMops, byRange.shard_count(), hashMops);
+        if (threads < maxThreads && threads * 2 > maxThreads) threads = maxThreads / 2;
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+// Benchmark de split, join y operaciones de conjuntos: recablear nodos
+// existentes frente a recorrer una lista e insertar cada elemento en otra.
+// Reporta ms y llamadas a operator new.
+//
+// Compilar (desde la raiz del repositorio):
+//   g++ -O2 -std=c++11 -I. -o bench_splice benchmarks/bench_splice.cpp
+//   ./bench_splice [n]      (por defecto 1000000)
+
+#define BENCH_COUNT_ALLOCATIONS
+
+#include "SkipList.h"
+#include "bench_util.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+typedef SkipList<int, int> List;
+
+// Lista con n claves aleatorias de [0, range)
+List build(size_t n, int range, unsigned seed) {
+    mt19937 rng(seed);
+    vector<pair<int, int>> entries;
+    entries.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        int key = static_cast<int>(rng() % static_cast<unsigned>(range));
+        entries.push_back(make_pair(key, key));
+    }
+    sort(entries.begin(), entries.end());
+    List list;
+    list.assign_sorted(entries.begin(), entries.end());
+    return list;
+}
+
+void report(const char* name, Clock::time_point start, size_t allocs) {
+    printf("%-34s %10.2f %12zu\n", name, msSince(start), g_allocations - allocs);
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+    int range = static_cast<int>(n * 2);
+    int pivot = range / 2;
+
+    printf("n=%zu por lista\n", n);
+    printf("%-34s %10s %12s\n", "operacion", "ms", "allocs");
+
+    {
+        List source = build(n, range, 1);
+        List target;
+        size_t allocs = g_allocations;
+        Clock::time_point start = Clock::now();
+        for (List::Iterator it = source.lower_bound(pivot); it != source.end(); ++it) {
+            target.insert(it.key(), it.value());
+        }
+        source.erase_range(pivot, range);
+        report("split: insert en bucle + erase", start, allocs);
+    }
+    {
+        List source = build(n, range, 1);
+        size_t allocs = g_allocations;
+        Clock::time_point start = Clock::now();
+        List target = source.split(pivot);
+        report("split(key)", start, allocs);
+
+        allocs = g_allocations;
+        start = Clock::now();
+        source.join(target);
+        report("join(other)", start, allocs);
+    }
+    {
+        List low = build(n / 2, pivot, 2);
+        List high = build(n / 2, pivot, 3);
+        size_t allocs = g_allocations;
+        Clock::time_point start = Clock::now();
+        for (List::Iterator it = high.begin(); it != high.end(); ++it) {
+            low.insert(it.key() + pivot, it.value());
+        }
+        high.clear();
+        report("join: insert en bucle", start, allocs);
+    }
+    {
+        List a = build(n, range, 4);
+        List b = build(n, range, 5);
+        size_t allocs = g_allocations;
+        Clock::time_point start = Clock::now();
+        for (List::Iterator it = b.begin(); it != b.end(); ++it) {
+            a.insert(it.key(), it.value());
+        }
+        b.clear();
+        report("union: insert en bucle", start, allocs);
+    }
+    {
+        List a = build(n, range, 4);
+        List b = build(n, range, 5);
+        size_t allocs = g_allocations;
+        Clock::time_point start = Clock::now();
+        a.unite(b);
+        report("unite(other)", start, allocs);
+    }
+    {
+        List a = build(n, range, 4);
+        List b = build(n, range, 5);
+        size_t allocs = g_allocations;
+        Clock::time_point start = Clock::now();
+        a.merge(b);
+        report("merge(other)", start, allocs);
+    }
+    {
+        List a = build(n, range, 4);
+        List b = build(n, range, 5);
+        size_t allocs = g_allocations;
+        Clock::time_point start = Clock::now();
+        List result;
+        for (List::Iterator it = a.begin(); it != a.end(); ++it) {
+            if (b.contains(it.key())) result.insert(it.key(), it.value());
+        }
+        report("interseccion: contains + insert", start, allocs);
+    }
+    {
+        List a = build(n, range, 4);
+        List b = build(n, range, 5);
+        size_t allocs = g_allocations;
+        Clock::time_point start = Clock::now();
+        a.intersect(b);
+        report("intersect(other)", start, allocs);
+    }
+    {
+        List a = build(n, range, 4);
+        List b = build(n, range, 5);
+        size_t allocs = g_allocations;
+        Clock::time_point start = Clock::now();
+        for (List::Iterator it = b.begin(); it != b.end(); ++it) {
+            a.remove(it.key());
+        }
+        report("diferencia: remove en bucle", start, allocs);
+    }
+    {
+        List a = build(n, range, 4);
+        List b = build(n, range, 5);
+        size_t allocs = g_allocations;
+        Clock::time_point start = Clock::now();
+        a.subtract(b);
+        report("subtract(other)", start, allocs);
+    }
+    return 0;
+}
@@ -0,0 +1,318 @@
+// Suite de benchmarks reproducible: SkipList frente a std::map,
+// std::unordered_map y un vector ordenado, con claves aleatorias, secuenciales
+// y Zipfian. Reporta ns/op, latencia p50/p99 por operacion y pico de RSS.
+//
+// Compilar (desde la raiz del repositorio):
+//   g++ -O2 -std=c++11 -I. -o bench_suite benchmarks/bench_suite.cpp
+//   ./bench_suite [maxN] [contenedor]
+//
+// maxN (por defecto 1000000) fija el mayor tamaño: se mide 10^3, 10^4, ...
+// hasta maxN (usar 10000000 para la corrida completa). Si se indica un
+// contenedor solo se ejecuta ese (SkipList, map, unordered_map, vector).
+// En POSIX cada combinacion corre en un proceso hijo para que el pico de RSS
+// sea el de ese contenedor.
+//
+// Claves: se insertan los impares 1, 3, ..., 2n-1; los fallos buscan pares.
+//   random      inserciones y busquedas en orden aleatorio uniforme
+//   sequential  inserciones y busquedas en orden ascendente
+//   zipfian     inserciones aleatorias, busquedas Zipf(0.99) sobre las claves
+// El vector ordenado se construye con push_back + sort, y su erase solo se
+// mide hasta 10^5 elementos (es O(n) por borrado).
+
+#include "SkipList.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+typedef int64_t Key;
+
+static const size_t SCAN_LENGTH = 100;
+static const size_t MAX_SCANS = 10000;
+static const size_t LATENCY_SAMPLES = 100000;
+static const size_t VECTOR_ERASE_LIMIT = 100000;
+
+struct SkipListAdapter {
+    static const char* name() { return "SkipList"; }
+    SkipList<Key, Key> c;
+
+    bool insertTimed(Key k) { return c.insert(k, k); }
+    bool find(Key k) const { return c.contains(k); }
+    bool erase(Key k) { return c.remove(k); }
+    bool canErase(size_t) const { return true; }
+    bool ordered() const { return true; }
+
+    Key scan(Key from, size_t len) {
+        Key sum = 0;
+        SkipList<Key, Key>::Iterator it = c.lower_bound(from);
+        for (size_t i = 0; i < len && it != c.end(); i++, ++it) sum += it.value();
+        return sum;
+    }
+
+    Key iterate() {
+        Key sum = 0;
+        for (SkipList<Key, Key>::Iterator it = c.begin(); it != c.end(); ++it) sum += it.value();
+        return sum;
+    }
+};
+
+struct MapAdapter {
+    static const char* name() { return "map"; }
+    map<Key, Key> c;
+
+    bool insertTimed(Key k) { return c.insert(make_pair(k, k)).second; }
+    bool find(Key k) const { return c.find(k) != c.end(); }
+    bool erase(Key k) { return c.erase(k) != 0; }
+    bool canErase(size_t) const { return true; }
+    bool ordered() const { return true; }
+
+    Key scan(Key from, size_t len) {
+        Key sum = 0;
+        map<Key, Key>::const_iterator it = c.lower_bound(from);
+        for (size_t i = 0; i < len && it != c.end(); i++, ++it) sum += it->second;
+        return sum;
+    }
+
+    Key iterate() {
+        Key sum = 0;
+        for (map<Key, Key>::const_iterator it = c.begin(); it != c.end(); ++it) sum += it->second;
+        return sum;
+    }
+};
+
+struct UnorderedMapAdapter {
+    static const char* name() { return "unordered_map"; }
+    unordered_map<Key, Key> c;
+
+    bool insertTimed(Key k) { return c.insert(make_pair(k, k)).second; }
+    bool find(Key k) const { return c.find(k) != c.end(); }
+    bool erase(Key k) { return c.erase(k) != 0; }
+    bool canErase(size_t) const { return true; }
+    bool ordered() const { return false; }
+    Key scan(Key, size_t) { return 0; }
+
+    Key iterate() {
+        Key sum = 0;
+        for (unordered_map<Key, Key>::const_iterator it = c.begin(); it != c.end(); ++it) sum += it->second;
+        return sum;
+    }
+};
+
+// Vector de pares ordenado por clave. insertTimed solo acumula: el orden se
+// restablece en finishInsert(), que se mide como parte de la insercion.
+struct SortedVectorAdapter {
+    static const char* name() { return "vector"; }
+    vector<pair<Key, Key> > c;
+
+    bool insertTimed(Key k) { c.push_back(make_pair(k, k)); return true; }
+    void finishInsert() { sort(c.begin(), c.end()); }
+
+    vector<pair<Key, Key> >::iterator lowerBound(Key k) {
+        return lower_bound(c.begin(), c.end(), make_pair(k, numeric_limits<Key>::min()));
+    }
+
+    bool find(Key k) {
+        vector<pair<Key, Key> >::iterator it = lowerBound(k);
+        return it != c.end() && it->first == k;
+    }
+
+    bool erase(Key k) {
+        vector<pair<Key, Key> >::iterator it = lowerBound(k);
+        if (it == c.end() || it->first != k) return false;
+        c.erase(it);
+        return true;
+    }
+
+    bool canErase(size_t n) const { return n <= VECTOR_ERASE_LIMIT; }
+    bool ordered() const { return true; }
+
+    Key scan(Key from, size_t len) {
+        Key sum = 0;
+        vector<pair<Key, Key> >::iterator it = lowerBound(from);
+        for (size_t i = 0; i < len && it != c.end(); i++, ++it) sum += it->second;
+        return sum;
+    }
+
+    Key iterate() {
+        Key sum = 0;
+        for (size_t i = 0; i < c.size(); i++) sum += c[i].second;
+        return sum;
+    }
+};
+
+template <typename A> void finishInsert(A&) {}
+void finishInsert(SortedVectorAdapter& a) { a.finishInsert(); }
+
+struct Result {
+    const char* op;
+    double nsPerOp;
+    double p50;
+    double p99;
+    bool valid;
+};
+
+struct Workload {
+    vector<Key> insertOrder;
+    vector<Key> hits;
+    vector<Key> misses;
+};
+
+static Workload makeWorkload(const string& dist, size_t n) {
+    Workload w;
+    w.insertOrder.resize(n);
+    for (size_t i = 0; i < n; i++) w.insertOrder[i] = static_cast<Key>(2 * i + 1);
+
+    mt19937_64 rng(20240601);
+    if (dist != "sequential") shuffle(w.insertOrder.begin(), w.insertOrder.end(), rng);
+
+    w.hits.resize(n);
+    w.misses.resize(n);
+    if (dist == "sequential") {
+        for (size_t i = 0; i < n; i++) {
+            w.hits[i] = static_cast<Key>(2 * i + 1);
+            w.misses[i] = static_cast<Key>(2 * i);
+        }
+    } else if (dist == "zipfian") {
+        ZipfGenerator zipf(n);
+        uniform_real_distribution<double> u(0.0, 1.0);
+        for (size_t i = 0; i < n; i++) {
+            // Dispersar los rangos calientes por todo el espacio de claves
+            uint64_t rank = (zipf(u(rng)) * 0x9E3779B97F4A7C15ULL) % n;
+            w.hits[i] = static_cast<Key>(2 * rank + 1);
+            w.misses[i] = static_cast<Key>(2 * rank);
+        }
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            uint64_t idx = rng() % n;
+            w.hits[i] = static_cast<Key>(2 * idx + 1);
+            w.misses[i] = static_cast<Key>(2 * idx);
+        }
+    }
+    return w;
+}
+
+// Ejecuta f(i) para i en [0, ops): tiempo total y latencia individual de una
+// muestra uniforme de LATENCY_SAMPLES operaciones.
+template <typename F>
+Result measure(const char* op, size_t ops, F f) {
+    Result r = { op, 0.0, 0.0, 0.0, true };
+    if (ops == 0) {
+        r.valid = false;
+        return r;
+    }
+    size_t stride = ops > LATENCY_SAMPLES ? ops / LATENCY_SAMPLES : 1;
+    vector<double> samples;
+    samples.reserve(ops / stride + 1);
+
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < ops; i++) {
+        if (i % stride == 0) {
+            Clock::time_point t = Clock::now();
+            f(i);
+            samples.push_back(chrono::duration<double, nano>(Clock::now() - t).count());
+        } else {
+            f(i);
+        }
+    }
+    r.nsPerOp = nsPerOp(start, ops);
+    r.p50 = percentile(samples, 50.0);
+    r.p99 = percentile(samples, 99.0);
+    return r;
+}
+
+static volatile Key g_sink = 0;
+
+template <typename A>
+void runOne(const string& dist, size_t n) {
+    Workload w = makeWorkload(dist, n);
+    A* a = new A();
+    vector<Result> results;
+
+    Result ins = measure("insert", n, [&](size_t i) { a->insertTimed(w.insertOrder[i]); });
+    Clock::time_point t = Clock::now();
+    finishInsert(*a);
+    ins.nsPerOp += msSince(t) * 1e6 / static_cast<double>(n);
+    results.push_back(ins);
+
+    results.push_back(measure("lookup_hit", n, [&](size_t i) { g_sink += a->find(w.hits[i]); }));
+    results.push_back(measure("lookup_miss", n, [&](size_t i) { g_sink += a->find(w.misses[i]); }));
+
+    size_t scans = a->ordered() ? min(n, MAX_SCANS) : 0;
+    results.push_back(measure("scan100", scans, [&](size_t i) { g_sink += a->scan(w.hits[i], SCAN_LENGTH); }));
+
+    t = Clock::now();
+    g_sink += a->iterate();
+    Result it = { "iterate", msSince(t) * 1e6 / static_cast<double>(n), 0.0, 0.0, true };
+    results.push_back(it);
+
+    size_t erases = a->canErase(n) ? n / 2 : 0;
+    results.push_back(measure("erase", erases, [&](size_t i) { a->erase(w.insertOrder[i]); }));
+
+    double rss = peakRssMB();
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        if (!r.valid) {
+            printf("%-14s %-11s %9zu %-12s %10s %10s %10s %9.1f\n",
+                   A::name(), dist.c_str(), n, r.op, "-", "-", "-", rss);
+        } else if (r.p50 == 0.0 && r.p99 == 0.0) {
+            printf("%-14s %-11s %9zu %-12s %10.1f %10s %10s %9.1f\n",
+                   A::name(), dist.c_str(), n, r.op, r.nsPerOp, "-", "-", rss);
+        } else {
+            printf("%-14s %-11s %9zu %-12s %10.1f %10.0f %10.0f %9.1f\n",
+                   A::name(), dist.c_str(), n, r.op, r.nsPerOp, r.p50, r.p99, rss);
+        }
+    }
+    fflush(stdout);
+    delete a;
+}
+
+template <typename A>
+void runIsolated(const string& dist, size_t n) {
+#if !defined(_WIN32)
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        runOne<A>(dist, n);
+        _exit(0);
+    }
+    if (pid > 0) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+        return;
+    }
+#endif
+    runOne<A>(dist, n);
+}
+
+int main(int argc, char** argv) {
+    size_t maxN = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+    string only = argc > 2 ? argv[2] : "";
+
+    const char* dists[] = { "random", "sequential", "zipfian" };
+
+    printf("%-14s %-11s %9s %-12s %10s %10s %10s %9s\n",
+           "contenedor", "claves", "n", "operacion", "ns/op", "p50 ns", "p99 ns", "RSS MB");
+
+    for (size_t n = 1000; n <= maxN; n *= 10) {
+        for (size_t d = 0; d < sizeof(dists) / sizeof(dists[0]); d++) {
+            string dist = dists[d];
+            if (only.empty() || only == SkipListAdapter::name()) runIsolated<SkipListAdapter>(dist, n);
+            if (only.empty() || only == MapAdapter::name()) runIsolated<MapAdapter>(dist, n);
+            if (only.empty() || only == UnorderedMapAdapter::name()) runIsolated<UnorderedMapAdapter>(dist, n);
+            if (only.empty() || only == SortedVectorAdapter::name()) runIsolated<SortedVectorAdapter>(dist, n);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Benchmark del layout desenrollado: SkipList (un nodo por clave) frente a
+// UnrolledSkipList con bloques de 16, 32 y 64 claves. Mide insercion
+// aleatoria, busquedas aleatorias, scans de 100 desde lower_bound y el
+// recorrido completo.
+//
+// Compilar (desde la raiz del repositorio):
+//   g++ -O2 -std=c++11 -I. -o bench_unrolled benchmarks/bench_unrolled.cpp
+//   g++ -O2 -mavx2 -std=c++11 -I. -o bench_unrolled benchmarks/bench_unrolled.cpp   (ruta AVX2)
+//   ./bench_unrolled [n1 n2 ...]      (por defecto 1000000 10000000)
+
+#include "SkipList.h"
+#include "UnrolledSkipList.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+
+static const size_t SCAN_LENGTH = 100;
+static const size_t SCANS = 100000;
+
+static volatile long long g_sink = 0;
+
+template <typename List>
+void run(const char* name, const vector<int>& keys, const vector<int>& probes) {
+    size_t n = keys.size();
+    List* sl = new List();
+
+    Clock::time_point t = Clock::now();
+    for (size_t i = 0; i < n; i++) sl->insert(keys[i], keys[i]);
+    double insertNs = nsPerOp(t, n);
+
+    t = Clock::now();
+    for (size_t i = 0; i < probes.size(); i++) g_sink += sl->contains(probes[i]);
+    double lookupNs = nsPerOp(t, probes.size());
+
+    long long sum = 0;
+    t = Clock::now();
+    for (size_t s = 0; s < SCANS; s++) {
+        typename List::Iterator it = sl->lower_bound(probes[s]);
+        for (size_t i = 0; i < SCAN_LENGTH && it != sl->end(); i++, ++it) sum += it.value();
+    }
+    double scanNs = nsPerOp(t, SCANS);
+
+    t = Clock::now();
+    for (typename List::Iterator it = sl->begin(); it != sl->end(); ++it) sum += it.value();
+    double iterateNs = nsPerOp(t, n);
+    g_sink += sum;
+
+    printf("%-18s %10zu %10.1f %10.1f %10.1f %10.2f %9.1f\n",
+           name, n, insertNs, lookupNs, scanNs, iterateNs, peakRssMB());
+    delete sl;
+}
+
+int main(int argc, char** argv) {
+    vector<size_t> sizes;
+    for (int i = 1; i < argc; i++) sizes.push_back(strtoul(argv[i], nullptr, 10));
+    if (sizes.empty()) {
+        sizes.push_back(1000000);
+        sizes.push_back(10000000);
+    }
+
+#if defined(__AVX2__)
+    printf("busqueda en bloque: AVX2\n");
+#elif defined(__SSE2__)
+    printf("busqueda en bloque: SSE2\n");
+#else
+    printf("busqueda en bloque: escalar\n");
+#endif
+    printf("%-18s %10s %10s %10s %10s %10s %9s\n",
+           "lista", "n", "insert ns", "lookup ns", "scan100 ns", "iter ns", "RSS MB");
+
+    for (size_t n : sizes) {
+        vector<int> keys(n);
+        mt19937 rng(42);
+        for (size_t i = 0; i < n; i++) keys[i] = static_cast<int>(rng());
+        vector<int> probes(n);
+        for (size_t i = 0; i < n; i++) probes[i] = keys[rng() % n];
+
+        run<SkipList<int, int>>("SkipList", keys, probes);
+        run<UnrolledSkipList<int, int, less<int>, 16>>("Unrolled<16>", keys, probes);
+        run<UnrolledSkipList<int, int, less<int>, 32>>("Unrolled<32>", keys, probes);
+        run<UnrolledSkipList<int, int, less<int>, 64>>("Unrolled<64>", keys, probes);
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+// Utilidades comunes de los benchmarks. Cada benchmark es un unico .cpp, por
+// eso este header puede reemplazar operator new/delete para contar allocs:
+// solo lo hace si el benchmark define BENCH_COUNT_ALLOCATIONS antes de
+// incluirlo. El contador no es atomico, asi que solo lo usan benchmarks de un
+// hilo; los que lanzan hilos miden con el operator new normal.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+#if defined(BENCH_COUNT_ALLOCATIONS)
+static size_t g_allocations = 0;
+
+BENCH_NOINLINE void* operator new(std::size_t size) {
+    g_allocations++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+BENCH_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+inline double nsPerOp(Clock::time_point start, size_t ops) {
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return ops ? ns / static_cast<double>(ops) : 0.0;
+}
+
+inline double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Percentil (0-100) de una muestra de latencias en ns; reordena la muestra.
+inline double percentile(std::vector<double>& samples, double pct) {
+    if (samples.empty()) return 0.0;
+    size_t idx = static_cast<size_t>(pct / 100.0 * static_cast<double>(samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + idx, samples.end());
+    return samples[idx];
+}
+
+// Pico de memoria residente del proceso en MB (0 si no esta disponible).
+inline double peakRssMB() {
+#if !defined(_WIN32)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+        return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0);
+#else
+        return static_cast<double>(usage.ru_maxrss) / 1024.0;
+#endif
+    }
+#endif
+    return 0.0;
+}
+
+// Generador Zipfian de Gray et al. ("Quickly generating billion-record
+// synthetic databases"), el mismo que usa YCSB: O(n) al construir, O(1) por
+// muestra. Devuelve rangos en [0, n); el 0 es el mas frecuente.
+class ZipfGenerator {
+private:
+    uint64_t n_;
+    double theta_;
+    double alpha_;
+    double zetan_;
+    double eta_;
+
+    static double zeta(uint64_t n, double theta) {
+        double sum = 0.0;
+        for (uint64_t i = 1; i <= n; i++) {
+            sum += 1.0 / std::pow(static_cast<double>(i), theta);
+        }
+        return sum;
+    }
+
+public:
+    explicit ZipfGenerator(uint64_t n, double theta = 0.99)
+        : n_(n), theta_(theta), alpha_(1.0 / (1.0 - theta)), zetan_(zeta(n, theta)) {
+        double zeta2 = zeta(2, theta);
+        eta_ = (1.0 - std::pow(2.0 / static_cast<double>(n), 1.0 - theta)) / (1.0 - zeta2 / zetan_);
+    }
+
+    // u uniforme en [0, 1)
+    uint64_t operator()(double u) const {
+        double uz = u * zetan_;
+        if (uz < 1.0) return 0;
+        if (uz < 1.0 + std::pow(0.5, theta_)) return n_ > 1 ? 1 : 0;
+        uint64_t rank = static_cast<uint64_t>(static_cast<double>(n_) * std::pow(eta_ * u - eta_ + 1.0, alpha_));
+        return rank < n_ ? rank : n_ - 1;
+    }
+};
+
+#endif
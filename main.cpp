@@ -1,7 +1,35 @@
 #include "SkipList.h"
+#include "SlabAllocator.h"
+#include "ConcurrentSkipList.h"
+#include "UnrolledSkipList.h"
+#include "VersionedSkipList.h"
+#include "MappedSkipList.h"
+#include "DurableSkipList.h"
+#include "ShardedSkipList.h"
+#include "OptimisticSkipList.h"
+#include "CacheSkipList.h"
 #include <iostream>
+#include <map>
+#include <memory>
 #include <string>
 #include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <functional>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <csignal>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -160,6 +188,16 @@ void testExceptionSafety() {
     cout << "  Creado exitosamente con maxLevel=16, prob=0.5" << endl;
 }
 
+struct Contador {
+    static int copias;
+    int valor;
+    explicit Contador(int v = 0) : valor(v) {}
+    Contador(const Contador& o) : valor(o.valor) { copias++; }
+    Contador& operator=(const Contador& o) { valor = o.valor; copias++; return *this; }
+};
+
+int Contador::copias = 0;
+
 void testEmplace() {
     cout << "\n========== TEST 7: Emplace ==========" << endl;
     
@@ -174,6 +212,14 @@ void testEmplace() {
     string val;
     sl.search(2, val);
     cout << "Valor con emplace: " << val << endl;
+    
+    // Una clave nueva se construye directamente en el nodo, sin copias
+    Contador::copias = 0;
+    SkipList<int, Contador> contadores;
+    contadores.emplace(1, 10);
+    contadores[2].valor = 20;
+    assert(Contador::copias == 0 && contadores.at(1).valor == 10);
+    cout << "Copias al hacer emplace/operator[]: " << Contador::copias << endl;
 }
 
 void testSwap() {
@@ -202,11 +248,11 @@ void testSwap() {
     sl2.display();
 }
 
-void testCustomComparator() { //Nuestra implementacion solo lo ordena de menor a mayor. 
+void testCustomComparator() {
     cout << "\n========== TEST 9: Comparador Personalizado ==========" << endl;
     
     // Skip list con orden descendente
-    SkipList<int, string> sl;
+    SkipList<int, string, greater<int>> sl;
     
     sl.insert(5, "cinco");
     sl.insert(2, "dos");
@@ -217,6 +263,20 @@ void testCustomComparator() { //Nuestra implementacion solo lo ordena de menor a
     for (auto it = sl.begin(); it != sl.end(); ++it) {
         cout << "  [" << it.key() << " -> " << it.value() << "]" << endl;
     }
+    assert(sl.begin().key() == 8);
+    sl.insert(5, "CINCO");  // equivalente: reemplaza, no duplica
+    assert(sl.size() == 4 && sl.at(5) == "CINCO");
+    
+    // Comparador transparente: busquedas con const char* sin construir string
+    SkipList<string, int, less<>> edades;
+    edades.insert("Alice", 25);
+    edades.insert("Bob", 30);
+    assert(edades.contains("Alice") && !edades.contains("Carol"));
+    assert(edades.at("Bob") == 30);
+    int edad = 0;
+    assert(edades.search("Alice", edad) && edad == 25);
+    assert(edades.find("Bob") != edades.end());
+    cout << "Busqueda heterogenea con less<>: Bob -> " << edades.at("Bob") << endl;
 }
 
 void testLargeDataset() {
@@ -250,6 +310,1545 @@ void testLargeDataset() {
     cout << "Max Level: " << sl.maxLevel() << endl;
 }
 
+void testSlabAllocator() {
+    cout << "\n========== TEST 11: SlabAllocator ==========" << endl;
+    
+    SkipList<int, string, less<int>, SlabAllocator<pair<const int, string>>> sl;
+    for (int i = 0; i < 1000; i++) {
+        sl.insert(i, "valor " + to_string(i));
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        sl.remove(i);
+    }
+    // Los nodos liberados se reciclan por altura
+    for (int i = 0; i < 1000; i += 2) {
+        sl.insert(i, "otra vez " + to_string(i));
+    }
+    assert(sl.size() == 1000);
+    cout << "Size tras borrar y reinsertar: " << sl.size() << endl;
+    
+    // La copia recibe su propio arena
+    SkipList<int, string, less<int>, SlabAllocator<pair<const int, string>>> copy(sl);
+    assert(copy.get_allocator() != sl.get_allocator());
+    sl.clear();
+    assert(sl.empty() && copy.size() == 1000);
+    cout << "Copia intacta tras clear() del original: " << copy.at(999) << endl;
+    
+    SkipList<int, string, less<int>, SlabAllocator<pair<const int, string>>> moved(move(copy));
+    assert(moved.size() == 1000 && copy.empty());
+    copy.insert(1, "uno");
+    cout << "Lista movida: " << moved.size() << ", origen reutilizado: " << copy.size() << endl;
+    
+    SkipList<int, int, less<int>, SlabAllocator<pair<const int, int>>> ints;
+    for (int i = 0; i < 100000; i++) {
+        ints.insert(i, i);
+    }
+    cout << "Bloques pedidos al sistema para 100000 nodos: "
+         << ints.get_allocator().chunk_allocations() << endl;
+    ints.clear();
+    ints.insert(7, 7);
+    assert(ints.size() == 1 && ints.at(7) == 7);
+}
+
+void testConcurrentSkipList() {
+    cout << "\n========== TEST 12: ConcurrentSkipList ==========" << endl;
+    
+    ConcurrentSkipList<int, string> csl;
+    bool nuevo = csl.insert(1, "uno");
+    assert(nuevo);
+    nuevo = csl.insert(1, "otro");
+    assert(!nuevo);  // no sobrescribe
+    string val;
+    assert(csl.search(1, val) && val == "uno");
+    bool borrado = csl.remove(1);
+    assert(borrado && !csl.contains(1));
+    borrado = csl.remove(1);
+    assert(!borrado);
+    
+    // Cada hilo inserta su propio rango y borra la mitad, mientras los demas
+    // recorren la lista
+    ConcurrentSkipList<int, int> shared;
+    const int threads = 4;
+    const int perThread = 5000;
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(thread([&shared, t]() {
+            int base = t * perThread;
+            for (int i = 0; i < perThread; i++) {
+                shared.insert(base + i, base + i);
+            }
+            for (int i = 0; i < perThread; i += 2) {
+                shared.remove(base + i);
+            }
+            int v = 0;
+            for (int i = 1; i < perThread; i += 2) {
+                assert(shared.search(base + i, v) && v == base + i);
+            }
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+    
+    size_t counted = 0;
+    int previous = -1;
+    shared.for_each([&](int key, int value) {
+        assert(key > previous && key == value && key % 2 == 1);
+        previous = key;
+        counted++;
+    });
+    assert(counted == shared.size());
+    cout << "Elementos tras " << threads << " hilos: " << shared.size()
+         << " (esperado " << threads * perThread / 2 << ")" << endl;
+    assert(shared.size() == static_cast<size_t>(threads * perThread / 2));
+}
+
+void testRangeQueries() {
+    cout << "\n========== TEST 13: Consultas por Rango ==========" << endl;
+    
+    SkipList<int, int> sl;
+    for (int i = 0; i < 100; i += 10) {
+        sl.insert(i, i * i);
+    }
+    
+    assert(sl.lower_bound(30).key() == 30);
+    assert(sl.lower_bound(31).key() == 40);
+    assert(sl.upper_bound(30).key() == 40);
+    assert(sl.lower_bound(1000) == sl.end());
+    
+    auto eq = sl.equal_range(50);
+    assert(eq.first.key() == 50 && eq.second.key() == 60);
+    eq = sl.equal_range(55);
+    assert(eq.first == eq.second && eq.first.key() == 60);
+    
+    cout << "Rango [25, 65):";
+    int visitados = 0;
+    for (auto par : sl.range(25, 65)) {
+        cout << " " << par.first;
+        visitados++;
+    }
+    cout << endl;
+    assert(visitados == 4);
+    assert(sl.range(65, 25).empty() && sl.range(91, 200).empty());
+    
+    size_t eliminados = sl.erase_range(20, 60);
+    cout << "erase_range(20, 60) elimino " << eliminados << " elementos" << endl;
+    assert(eliminados == 4 && sl.size() == 6);
+    assert(!sl.contains(20) && !sl.contains(50) && sl.contains(10) && sl.contains(60));
+    sl.display();
+    
+    eliminados = sl.erase_range(-100, 1000);
+    assert(eliminados == 6 && sl.empty() && sl.maxLevel() == 0);
+    sl.insert(1, 1);
+    assert(sl.size() == 1 && sl.at(1) == 1);
+}
+
+void testOrderStatistics() {
+    cout << "\n========== TEST 14: Estadisticos de Orden ==========" << endl;
+    
+    SkipList<int, int> sl;
+    vector<int> claves;
+    mt19937 rng(7);
+    for (int i = 0; i < 2000; i++) {
+        int k = static_cast<int>(rng() % 5000);
+        if (sl.insert(k, k)) claves.push_back(k);
+    }
+    for (int i = 0; i < 500; i++) {
+        int k = static_cast<int>(rng() % 5000);
+        if (sl.remove(k)) claves.erase(find(claves.begin(), claves.end(), k));
+    }
+    sl.erase_range(1000, 1500);
+    claves.erase(remove_if(claves.begin(), claves.end(),
+                           [](int k) { return k >= 1000 && k < 1500; }), claves.end());
+    SkipList<int, int> copia(sl);
+    sort(claves.begin(), claves.end());
+    
+    assert(sl.size() == claves.size());
+    for (size_t i = 0; i < claves.size(); i++) {
+        assert(sl.select(i).key() == claves[i]);
+        assert(sl.rank(claves[i]) == i);
+        assert(copia.select(i).key() == claves[i]);
+    }
+    assert(sl.select(claves.size()) == sl.end());
+    assert(sl.count_in_range(0, 5000) == claves.size());
+    assert(sl.count_in_range(1000, 1500) == 0);
+    assert(sl.advance(sl.begin(), 10).key() == claves[10]);
+    
+    SkipList<int, int> latencias;
+    for (int i = 1; i <= 1000; i++) {
+        latencias[i] = i;
+    }
+    cout << "p50 = " << latencias.percentile(50).key()
+         << ", p99 = " << latencias.percentile(99).key()
+         << ", rank(250) = " << latencias.rank(250) << endl;
+    assert(latencias.percentile(99).key() == 990 && latencias.percentile(0).key() == 1);
+    assert(latencias.count_in_range(100, 200) == 100);
+}
+
+void testBulkLoad() {
+    cout << "\n========== TEST 15: Carga Masiva ==========" << endl;
+    
+    vector<pair<int, int>> ordenados;
+    for (int i = 0; i < 1000; i++) {
+        ordenados.push_back(make_pair(i * 2, i));
+    }
+    ordenados.push_back(make_pair(1998, -1));  // repetida: gana la ultima
+    
+    auto sl = SkipList<int, int>::from_sorted(ordenados.begin(), ordenados.end());
+    assert(sl.size() == 1000 && sl.at(1998) == -1 && sl.at(500) == 250);
+    assert(sl.select(10).key() == 20 && sl.rank(20) == 10);
+    
+    SkipList<int, int> balanceada;
+    balanceada.assign_sorted(ordenados.begin(), ordenados.end(), true);
+    cout << "Balanceada: " << balanceada.size() << " elementos, nivel maximo "
+         << balanceada.maxLevel() << endl;
+    assert(balanceada.size() == 1000 && balanceada.maxLevel() == 9);
+    assert(balanceada.count_in_range(100, 200) == 50);
+    
+    vector<pair<int, int>> desordenados = { {5, 5}, {3, 3} };
+    bool lanzo = false;
+    try {
+        balanceada.assign_sorted(desordenados.begin(), desordenados.end());
+    } catch (const invalid_argument& e) {
+        cout << "Excepcion capturada: " << e.what() << endl;
+        lanzo = true;
+    }
+    assert(lanzo && balanceada.size() == 1000);
+    
+    vector<pair<int, int>> lote;
+    mt19937 rng(11);
+    for (int i = 0; i < 500; i++) {
+        int k = static_cast<int>(rng() % 2500);
+        lote.push_back(make_pair(k, -k));
+    }
+    SkipList<int, int> esperado(sl);
+    size_t nuevas = 0;
+    for (auto& par : lote) {
+        if (esperado.insert(par.first, par.second)) nuevas++;
+    }
+    size_t insertadas = sl.insert_batch(lote.begin(), lote.end());
+    assert(insertadas == nuevas);
+    assert(sl.size() == esperado.size());
+    size_t i = 0;
+    for (auto it = esperado.begin(); it != esperado.end(); ++it, i++) {
+        assert(sl.select(i).key() == it.key() && sl.select(i).value() == it.value());
+    }
+    cout << "insert_batch agrego " << nuevas << " claves nuevas" << endl;
+}
+
+void testFingerSearch() {
+    cout << "\n========== TEST 16: Busqueda con Dedo ==========" << endl;
+    
+    // Flujo casi ordenado: marcas de tiempo con jitter
+    SkipList<int, int> sl;
+    SkipList<int, int> esperado;
+    mt19937 rng(3);
+    auto it = sl.end();
+    for (int i = 0; i < 3000; i++) {
+        int k = i * 4 + static_cast<int>(rng() % 21) - 10;
+        it = sl.insert(it, k, i);
+        esperado.insert(k, i);
+        assert(it.key() == k && it.value() == i);
+        if (i % 500 == 499) {
+            sl.remove(k);  // invalida el dedo
+            esperado.remove(k);
+            it = sl.end();
+        }
+    }
+    assert(sl.size() == esperado.size());
+    size_t pos = 0;
+    for (auto e = esperado.begin(); e != esperado.end(); ++e, pos++) {
+        assert(sl.select(pos).key() == e.key() && sl.select(pos).value() == e.value());
+        assert(sl.rank(e.key()) == pos);
+    }
+    
+    auto pista = sl.begin();
+    for (auto e = esperado.begin(); e != esperado.end(); ++e) {
+        pista = sl.find(pista, e.key());
+        assert(pista != sl.end() && pista.key() == e.key());
+    }
+    assert(sl.find(sl.begin(), 1000000) == sl.end());
+    assert(sl.find(sl.select(100), sl.select(50).key()) == sl.select(50));
+    
+    auto nuevo = sl.insert(sl.find(40), 40, -40);
+    assert(nuevo.key() == 40 && sl.at(40) == -40);
+    cout << "Insertados con pista: " << sl.size() << " elementos" << endl;
+}
+
+void testUnrolledSkipList() {
+    cout << "\n========== TEST 17: UnrolledSkipList ==========" << endl;
+    
+    UnrolledSkipList<int, int, less<int>, 8> usl;
+    map<int, int> referencia;
+    mt19937 rng(5);
+    for (int i = 0; i < 20000; i++) {
+        int k = static_cast<int>(rng() % 3000);
+        if (rng() % 3 == 0) {
+            bool borrado = usl.remove(k);
+            bool enReferencia = referencia.erase(k) == 1;
+            assert(borrado == enReferencia);
+        } else {
+            bool nuevo = usl.insert(k, i);
+            assert(nuevo == (referencia.count(k) == 0));
+            referencia[k] = i;
+        }
+    }
+    assert(usl.size() == referencia.size());
+    auto ref = referencia.begin();
+    for (auto it = usl.begin(); it != usl.end(); ++it, ++ref) {
+        assert(it.key() == ref->first && it.value() == ref->second);
+    }
+    assert(ref == referencia.end());
+    for (int k = -5; k < 3005; k++) {
+        int valor;
+        assert(usl.search(k, valor) == (referencia.count(k) == 1));
+        auto lb = usl.lower_bound(k);
+        auto refLb = referencia.lower_bound(k);
+        assert(refLb == referencia.end() ? lb == usl.end() : lb.key() == refLb->first);
+    }
+    cout << "Elementos: " << usl.size() << ", bloques: " << usl.blockCount() << endl;
+    
+    // Claves no enteras: busqueda escalar dentro del bloque
+    UnrolledSkipList<string, int> nombres;
+    nombres.insert("carlos", 3);
+    nombres.insert("ana", 1);
+    nombres.insert("beatriz", 2);
+    UnrolledSkipList<string, int> copia(nombres);
+    nombres.remove("ana");
+    assert(nombres.size() == 2 && copia.size() == 3 && copia.at("ana") == 1);
+    assert(copia.begin().key() == "ana" && nombres.begin().key() == "beatriz");
+    
+    // Insercion secuencial: los bloques llenos no se parten
+    UnrolledSkipList<long long, long long> secuencial;
+    for (long long i = 0; i < 1000; i++) {
+        secuencial.insert(i, i);
+    }
+    assert(secuencial.blockCount() == 1000 / 32 + 1 && secuencial.contains(999));
+    secuencial.clear();
+    assert(secuencial.empty() && secuencial.begin() == secuencial.end());
+}
+
+void testMultiFind() {
+    cout << "\n========== TEST 18: Busqueda por Lotes ==========" << endl;
+    
+    SkipList<int, int> sl;
+    for (int i = 0; i < 5000; i += 3) {
+        sl.insert(i, -i);
+    }
+    
+    vector<int> claves;
+    mt19937 rng(13);
+    for (int i = 0; i < 100; i++) {
+        claves.push_back(static_cast<int>(rng() % 6000));
+    }
+    
+    vector<SkipList<int, int>::Iterator> encontrados;
+    sl.multi_find(claves.begin(), claves.end(), back_inserter(encontrados));
+    assert(encontrados.size() == claves.size());
+    for (size_t i = 0; i < claves.size(); i++) {
+        assert(encontrados[i] == sl.find(claves[i]));
+    }
+    
+    vector<bool> presentes;
+    size_t n = sl.contains_batch(claves.begin(), claves.end(), back_inserter(presentes));
+    size_t esperados = 0;
+    for (size_t i = 0; i < claves.size(); i++) {
+        assert(presentes[i] == sl.contains(claves[i]));
+        esperados += presentes[i];
+    }
+    assert(n == esperados);
+    
+    // Lote ordenado: reutiliza el camino de la clave anterior
+    sort(claves.begin(), claves.end());
+    presentes.clear();
+    n = sl.contains_batch(claves.begin(), claves.end(), back_inserter(presentes));
+    assert(n == esperados);
+    for (size_t i = 0; i < claves.size(); i++) {
+        assert(presentes[i] == sl.contains(claves[i]));
+    }
+    
+    // Lote denso: cada clave a pocas posiciones de la anterior
+    vector<int> densas;
+    for (int k = 300; k < 600; k++) {
+        densas.push_back(k);
+    }
+    encontrados.clear();
+    sl.multi_find(densas.begin(), densas.end(), back_inserter(encontrados));
+    for (size_t i = 0; i < densas.size(); i++) {
+        assert(encontrados[i] == sl.find(densas[i]));
+    }
+    cout << esperados << " de " << claves.size() << " claves encontradas" << endl;
+}
+
+void testSnapshots() {
+    cout << "\n========== TEST 19: Snapshots MVCC ==========" << endl;
+    
+    VersionedSkipList<int, string> vsl;
+    vsl.put(1, "uno");
+    vsl.put(2, "dos");
+    vsl.put(3, "tres");
+    
+    {
+        auto antes = vsl.snapshot();
+        vsl.put(2, "DOS");
+        vsl.remove(3);
+        vsl.put(4, "cuatro");
+        
+        string valor;
+        assert(antes.get(2, valor) && valor == "dos");
+        assert(antes.contains(3) && !antes.contains(4));
+        assert(vsl.get(2, valor) && valor == "DOS");
+        assert(!vsl.contains(3) && vsl.contains(4) && vsl.size() == 3);
+        
+        cout << "Snapshot en secuencia " << antes.sequence() << ":";
+        int claves = 0;
+        for (auto par : antes) {
+            cout << " " << par.first << "=" << par.second;
+            claves++;
+        }
+        cout << endl;
+        assert(claves == 3);
+        
+        // Con el snapshot vivo gc no puede descartar lo que este ve
+        size_t descartadas = vsl.gc();
+        assert(vsl.version_count() == 6 && descartadas == 0);
+    }
+    auto despues = vsl.snapshot();
+    assert(despues.lower_bound(2).key() == 2 && despues.lower_bound(3).key() == 4);
+    // "dos", "tres" y la lapida de 3 (con su nodo)
+    size_t descartadas = vsl.gc();
+    assert(descartadas == 3 && vsl.version_count() == 3);
+    assert(despues.contains(1) && !despues.contains(3));
+    
+    // Un escritor reescribe las claves 0..99 con generaciones crecientes
+    // mientras un lector recorre snapshots: cada uno debe ver un prefijo de
+    // la generacion g seguido de la generacion g - 1.
+    VersionedSkipList<int, int> tabla;
+    for (int k = 0; k < 100; k++) {
+        tabla.put(k, 0);
+    }
+    atomic<bool> fin(false);
+    thread escritor([&tabla, &fin]() {
+        for (int g = 1; g <= 200; g++) {
+            for (int k = 0; k < 100; k++) {
+                tabla.put(k, g);
+            }
+            if (g % 20 == 0) tabla.gc();
+        }
+        fin = true;
+    });
+    int lecturas = 0;
+    while (!fin || lecturas == 0) {
+        auto snap = tabla.snapshot();
+        int anterior = -1;
+        int vistos = 0;
+        for (auto it = snap.begin(); it != snap.end(); ++it, vistos++) {
+            assert(anterior == -1 || it.value() == anterior || it.value() == anterior - 1);
+            anterior = it.value();
+        }
+        assert(vistos == 100);
+        lecturas++;
+    }
+    escritor.join();
+    tabla.gc();
+    assert(tabla.version_count() == 100);
+    cout << "Recorridos consistentes durante escrituras: " << lecturas << endl;
+}
+
+void testPersistence() {
+    cout << "\n========== TEST 20: Persistencia ==========" << endl;
+    
+    const char* ruta = "test_skiplist.bin";
+    SkipList<int, double> sl;
+    for (int i = 0; i < 5000; i++) {
+        sl.insert(i * 7 % 5003, i * 0.5);
+    }
+    sl.save(ruta);
+    
+    SkipList<int, double> cargada;
+    cargada.insert(-1, -1.0);
+    cargada.load(ruta);
+    assert(cargada.size() == sl.size() && !cargada.contains(-1));
+    assert(cargada.maxLevel() == sl.maxLevel());
+    for (size_t i = 0; i < sl.size(); i += 97) {
+        assert(cargada.select(i).key() == sl.select(i).key());
+        assert(cargada.select(i).value() == sl.select(i).value());
+    }
+    
+    {
+        MappedSkipList<int, double> mapeada(ruta);
+        mapeada.verify();
+        double valor;
+        assert(mapeada.size() == sl.size());
+        assert(mapeada.search(7, valor) && valor == 0.5 && !mapeada.contains(5003));
+        assert(mapeada.rank(100) == sl.rank(100) && mapeada.lower_bound(4999).key() == 4999);
+        cout << "Mapeada: " << mapeada.size() << " elementos, primera clave "
+             << mapeada.begin().key() << endl;
+    }
+    {
+        // El archivo no guarda el comparador: verify() detecta uno distinto
+        SkipList<int, double, greater<int>> inversa;
+        for (int i = 0; i < 100; i++) inversa.insert(i, i);
+        inversa.save("test_inversa.bin");
+        MappedSkipList<int, double, greater<int>> igual("test_inversa.bin");
+        igual.verify();
+        MappedSkipList<int, double> distinta("test_inversa.bin");
+        bool rechazada = false;
+        try {
+            distinta.verify();
+        } catch (const runtime_error&) {
+            rechazada = true;
+        }
+        assert(rechazada);
+        remove("test_inversa.bin");
+    }
+    
+    // Un byte alterado o un archivo truncado se rechazan sin tocar la lista
+    {
+        fstream archivo(ruta, ios::in | ios::out | ios::binary);
+        archivo.seekp(1000);
+        archivo.put('\x7f');
+    }
+    bool lanzo = false;
+    try {
+        cargada.load(ruta);
+    } catch (const runtime_error& e) {
+        cout << "Excepcion capturada: " << e.what() << endl;
+        lanzo = true;
+    }
+    assert(lanzo && cargada.size() == sl.size());
+    
+    // Tipos no triviales: formato con skiplist_codec
+    SkipList<string, string> nombres;
+    nombres.insert("ana", "uno");
+    nombres.insert("beatriz", "dos");
+    nombres.insert("carlos", "");
+    nombres.save(ruta);
+    SkipList<string, string> copia;
+    copia.load(ruta);
+    assert(copia.size() == 3 && copia.at("beatriz") == "dos" && copia.at("carlos").empty());
+    
+    {
+        ifstream in(ruta, ios::binary);
+        string contenido((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        ofstream out(ruta, ios::binary | ios::trunc);
+        out.write(contenido.data(), static_cast<streamsize>(contenido.size() - 8));
+    }
+    lanzo = false;
+    try {
+        copia.load(ruta);
+    } catch (const runtime_error&) {
+        lanzo = true;
+    }
+    assert(lanzo && copia.size() == 3);
+    remove(ruta);
+}
+
+// Recorta o altera el final del log para simular una escritura interrumpida
+static void danarFinalDelLog(const string& ruta, size_t recorte, bool alterar) {
+    string contenido;
+    {
+        ifstream in(ruta.c_str(), ios::binary);
+        contenido.assign((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    }
+    contenido.resize(contenido.size() - recorte);
+    if (alterar) contenido[contenido.size() - 12] ^= 0x55;
+    ofstream out(ruta.c_str(), ios::binary | ios::trunc);
+    out.write(contenido.data(), static_cast<streamsize>(contenido.size()));
+}
+
+void testDurableSkipList() {
+    cout << "\n========== TEST 21: Write-ahead log ==========" << endl;
+    
+    const string base = "test_durable";
+    remove((base + ".wal").c_str());
+    remove((base + ".snap").c_str());
+    
+    {
+        DurableSkipList<int, string> dl(base);
+        for (int i = 0; i < 100; i++) {
+            dl.insert(i, "v" + to_string(i));
+        }
+        for (int i = 0; i < 10; i++) {
+            bool borrado = dl.remove(i * 10);
+            assert(borrado);
+        }
+        bool borrado = dl.remove(0);
+        assert(!borrado);
+        dl.insert(1000, "ultimo");
+    }
+    {
+        DurableSkipList<int, string> dl(base);
+        assert(dl.recovered_records() == 111 && dl.discarded_bytes() == 0);
+        assert(dl.size() == 91 && dl.at(55) == "v55" && !dl.contains(20));
+    }
+    
+    // Caida a mitad del ultimo registro: se descarta y el log sigue usable
+    danarFinalDelLog(base + ".wal", 5, false);
+    {
+        DurableSkipList<int, string> dl(base);
+        assert(dl.discarded_bytes() > 0 && dl.size() == 90 && !dl.contains(1000));
+        dl.insert(2000, "despues");
+    }
+    danarFinalDelLog(base + ".wal", 0, true);
+    {
+        DurableSkipList<int, string> dl(base);
+        assert(dl.size() == 90 && !dl.contains(2000));
+        cout << "Recuperados " << dl.recovered_records() << " registros, descartados "
+             << dl.discarded_bytes() << " bytes" << endl;
+        
+        dl.clear();
+        dl.insert(1, "uno");
+        dl.insert(2, "dos");
+        dl.checkpoint();
+        dl.insert(3, "tres");
+    }
+    {
+        DurableSkipList<int, string> dl(base);
+        assert(dl.recovered_records() == 1 && dl.size() == 3 && dl.at(3) == "tres");
+    }
+    
+    // Escritores concurrentes comparten fsync (group commit)
+    DurableOptions opciones;
+    opciones.groupCommitDelay = chrono::microseconds(200);
+    {
+        DurableSkipList<int, string> dl(base, opciones);
+        vector<thread> hilos;
+        for (int t = 0; t < 4; t++) {
+            hilos.push_back(thread([&dl, t]() {
+                for (int i = 0; i < 100; i++) {
+                    dl.insert(1000 + t * 100 + i, "x");
+                }
+            }));
+        }
+        for (auto& h : hilos) h.join();
+        assert(dl.size() == 403 && dl.log_syncs() <= 400);
+        cout << "400 escrituras en " << dl.log_syncs() << " fsync" << endl;
+    }
+    {
+        DurableSkipList<int, string> dl(base);
+        assert(dl.size() == 403 && dl.contains(1399));
+    }
+    
+#if !defined(_WIN32)
+    // Si el rename del checkpoint falla, el log no se vacia
+    const string otra = "test_durable_ckpt";
+    remove((otra + ".wal").c_str());
+    {
+        DurableSkipList<int, string> dl(otra);
+        dl.insert(1, "antes");
+        mkdir((otra + ".snap").c_str(), 0755);
+        mkdir((otra + ".snap/ocupado").c_str(), 0755);
+        bool lanzo = false;
+        try {
+            dl.checkpoint();
+        } catch (const runtime_error&) {
+            lanzo = true;
+        }
+        assert(lanzo && dl.log_bytes() > 0);
+        dl.insert(2, "despues");
+    }
+    rmdir((otra + ".snap/ocupado").c_str());
+    rmdir((otra + ".snap").c_str());
+    {
+        DurableSkipList<int, string> dl(otra);
+        assert(dl.size() == 2 && dl.at(1) == "antes" && dl.at(2) == "despues");
+        assert(!ifstream((otra + ".snap.tmp").c_str()));
+    }
+    remove((otra + ".wal").c_str());
+    
+    // Si el log no se puede escribir (aca, por el limite de tamaño de
+    // archivo), insert lanza, la lista no cambia y queda de solo lectura
+    remove((otra + ".snap").c_str());
+    void (*senal)(int) = signal(SIGXFSZ, SIG_IGN);
+    {
+        DurableSkipList<int, string> dl(otra);
+        dl.insert(1, "uno");
+        struct rlimit limite;
+        getrlimit(RLIMIT_FSIZE, &limite);
+        struct rlimit chico = limite;
+        chico.rlim_cur = static_cast<rlim_t>(dl.log_bytes());
+        setrlimit(RLIMIT_FSIZE, &chico);
+        bool lanzo = false;
+        try {
+            dl.insert(2, "dos");
+        } catch (const runtime_error&) {
+            lanzo = true;
+        }
+        setrlimit(RLIMIT_FSIZE, &limite);
+        assert(lanzo && !dl.contains(2) && dl.size() == 1);
+        lanzo = false;
+        try {
+            dl.remove(1);
+        } catch (const runtime_error&) {
+            lanzo = true;
+        }
+        assert(lanzo && dl.contains(1));
+    }
+    signal(SIGXFSZ, senal);
+    {
+        DurableSkipList<int, string> dl(otra);
+        assert(dl.size() == 1 && dl.at(1) == "uno");
+    }
+    remove((otra + ".wal").c_str());
+#endif
+    remove((base + ".wal").c_str());
+    remove((base + ".snap").c_str());
+}
+
+// Recorre la lista hacia atras y verifica que sea la inversa del recorrido
+// hacia adelante
+template<typename List>
+static void verificarEnlacesInversos(const List& sl) {
+    vector<int> adelante, atras;
+    for (auto it = sl.cbegin(); it != sl.cend(); ++it) adelante.push_back(it.key());
+    for (auto it = sl.crbegin(); it != sl.crend(); ++it) atras.push_back((*it).first);
+    reverse(atras.begin(), atras.end());
+    assert(adelante == atras && adelante.size() == sl.size());
+    assert(sl.empty() ? sl.last() == sl.end() : sl.last().key() == adelante.back());
+}
+
+void testReverseIteration() {
+    cout << "\n========== TEST 22: Iteracion inversa ==========" << endl;
+    
+    SkipList<int, int> sl;
+    assert(sl.last() == sl.end() && sl.rbegin() == sl.rend());
+    for (int t = 0; t < 1000; t++) {
+        sl.insert(t * 3, t);
+    }
+    verificarEnlacesInversos(sl);
+    
+    // Ultimas 5 entradas por clave, sin recorrer la lista desde begin()
+    vector<int> recientes;
+    for (auto it = sl.rbegin(); it != sl.rend() && recientes.size() < 5; ++it) {
+        recientes.push_back((*it).first);
+    }
+    assert(recientes == vector<int>({2997, 2994, 2991, 2988, 2985}));
+    
+    auto it = sl.end();
+    --it;
+    assert(it == sl.last() && it.key() == 2997);
+    it = sl.find(300);
+    --it;
+    assert(it.key() == 297);
+    
+    // Todas las modificaciones mantienen los enlaces hacia atras
+    sl.remove(2997);
+    sl.remove(0);
+    sl.remove(1500);
+    sl[3001] = 1;
+    sl[-5] = 1;
+    sl.erase_range(2000, 2500);
+    sl.erase_range(2900, 4000);
+    verificarEnlacesInversos(sl);
+    
+    vector<pair<int, int>> lote;
+    for (int i = 0; i < 200; i++) lote.push_back(make_pair(i * 17 % 4000, i));
+    sl.insert_batch(lote.begin(), lote.end());
+    auto pista = sl.begin();
+    for (int i = 4000; i < 4100; i++) pista = sl.insert(pista, i, i);
+    verificarEnlacesInversos(sl);
+    
+    const SkipList<int, int> copia(sl);
+    verificarEnlacesInversos(copia);
+    SkipList<int, int>::const_iterator c = copia.lower_bound(4050);
+    assert(c.key() == 4050 && (--c).key() == 4049);
+    
+    vector<pair<int, int>> ordenados;
+    for (int i = 0; i < 300; i++) ordenados.push_back(make_pair(i, i));
+    SkipList<int, int> construida = SkipList<int, int>::from_sorted(ordenados.begin(), ordenados.end());
+    verificarEnlacesInversos(construida);
+    
+    const char* ruta = "test_reverse.bin";
+    construida.save(ruta);
+    SkipList<int, int> cargada;
+    cargada.load(ruta);
+    remove(ruta);
+    verificarEnlacesInversos(cargada);
+    
+    cargada.clear();
+    verificarEnlacesInversos(cargada);
+    cout << "Ultima clave: " << copia.last().key() << ", tamaño " << copia.size() << endl;
+}
+
+void testStats() {
+    cout << "\n========== TEST 23: Estadisticas ==========" << endl;
+    
+    vector<pair<int, int>> datos;
+    for (int i = 0; i < 1024; i++) datos.push_back(make_pair(i * 2, i));
+    SkipList<int, int> sl = SkipList<int, int>::from_sorted(datos.begin(), datos.end(), true);
+    sl.reset_stats();
+    
+    for (int i = 0; i < 100; i++) sl.insert(i * 2 + 1, i);
+    int encontrados = 0;
+    for (int i = 0; i < 50; i++) encontrados += sl.contains(i * 40);
+    for (int i = 0; i < 10; i++) sl.remove(i * 2 + 1);
+    assert(encontrados == 50);
+    
+    SkipListStats st = sl.stats();
+    assert(st.size == 1114 && st.levelNodes.size() == static_cast<size_t>(st.maxLevel) + 1);
+    assert(st.levelNodes[0] == st.size);
+    for (size_t i = 1; i < st.levelNodes.size(); i++) {
+        assert(st.levelNodes[i] <= st.levelNodes[i - 1]);
+    }
+    assert(st.keyValueBytes == st.size * 2 * sizeof(int));
+    assert(st.keyValueBytes + st.nodeOverheadBytes + st.towerBytes + st.spanBytes + st.headerBytes
+           <= st.totalBytes);
+    
+    string json = st.to_json();
+    assert(json.find("\"level_nodes\":[1114,") != string::npos);
+    assert(json.front() == '{' && json.back() == '}');
+    
+#ifdef SKIPLIST_STATS
+    assert(st.countersEnabled);
+    assert(st.inserts == 100 && st.lookups == 50 && st.removes == 10);
+    assert(st.searches == 160 && st.maxHops >= 1 && st.averageHops() > 0.0);
+    assert(st.comparisons >= st.totalHops);
+    uint64_t muestras = 0;
+    for (size_t b = 0; b < st.lookupLatency.size(); b++) muestras += st.lookupLatency[b];
+    assert(muestras == 50 && SkipListStats::latencyPercentile(st.lookupLatency, 99.0) > 0);
+    cout << "Saltos promedio: " << st.averageHops() << ", comparaciones por busqueda: "
+         << st.comparisonsPerSearch() << endl;
+#else
+    assert(!st.countersEnabled && st.searches == 0 && st.inserts == 0);
+#endif
+    cout << json.substr(0, 80) << "..." << endl;
+}
+
+void testLevelGenerator() {
+    cout << "\n========== TEST 24: Generador de niveles ==========" << endl;
+    
+    // Misma semilla y mismas operaciones: misma estructura
+    SkipList<int, int> a, b;
+    a.seed(42);
+    b.seed(42);
+    for (int i = 0; i < 2000; i++) {
+        a.insert(i * 7 % 2003, i);
+        b.insert(i * 7 % 2003, i);
+    }
+    assert(a.stats().levelNodes == b.stats().levelNodes && a.maxLevel() == b.maxLevel());
+    
+    // assign_sorted y load reemplazan el contenido pero no la semilla
+    vector<pair<int, int>> ordenados;
+    for (int i = 0; i < 1000; i++) ordenados.push_back(make_pair(i * 2, i));
+    a.save("test_semilla.bin");
+    SkipList<int, int> c, d, e;
+    c.seed(42);
+    d.seed(42);
+    e.seed(43);
+    c.assign_sorted(ordenados.begin(), ordenados.end());
+    d.assign_sorted(ordenados.begin(), ordenados.end());
+    e.assign_sorted(ordenados.begin(), ordenados.end());
+    assert(c.stats().levelNodes == d.stats().levelNodes && c.stats().levelNodes != e.stats().levelNodes);
+    c.load("test_semilla.bin");
+    d.load("test_semilla.bin");
+    for (int i = 0; i < 2000; i++) {
+        c.insert(i * 2 + 5000, i);
+        d.insert(i * 2 + 5000, i);
+    }
+    assert(c.stats().levelNodes == d.stats().levelNodes && c.maxLevel() == d.maxLevel());
+    remove("test_semilla.bin");
+    
+    // P(nivel >= 1) = p por el camino de ceros finales (1/2, 1/4) y por el
+    // de logaritmo (0.3)
+    const float probabilidades[] = { 0.5f, 0.25f, 0.3f };
+    for (float p : probabilidades) {
+        SkipList<int, int> sl(16, p);
+        sl.seed(7);
+        for (int i = 0; i < 20000; i++) sl.insert(i, i);
+        double fraccion = static_cast<double>(sl.stats().levelNodes[1]) / 20000.0;
+        assert(fabs(fraccion - p) < 0.02);
+    }
+    
+    SkipList<int, int, less<int>, allocator<pair<const int, int>>, MersenneLevelGenerator> mt1, mt2;
+    mt1.seed(3);
+    mt2.seed(3);
+    for (int i = 0; i < 500; i++) {
+        mt1.insert(i, i);
+        mt2.insert(i, i);
+    }
+    assert(mt1.stats().levelNodes == mt2.stats().levelNodes);
+    
+    // AUTO_LEVEL: la altura sigue a log2(n) en vez de llegar a maxLevel
+    SkipList<int, int> autoNivel(SkipList<int, int>::AUTO_LEVEL);
+    autoNivel.seed(1);
+    for (int i = 0; i < 1000; i++) autoNivel.insert(i, i);
+    assert(autoNivel.maxLevel() <= 10);
+    for (int i = 1000; i < 50000; i++) autoNivel.insert(i, i);
+    assert(autoNivel.maxLevel() <= 16 && autoNivel.maxLevel() >= 10);
+    SkipList<int, int> copia(autoNivel);
+    copia.clear();
+    for (int i = 0; i < 100; i++) copia.insert(i, i);
+    assert(copia.maxLevel() <= 7);
+    
+    bool lanzo = false;
+    try {
+        SkipList<int, int> invalida(-2);
+    } catch (const invalid_argument&) {
+        lanzo = true;
+    }
+    assert(lanzo);
+    cout << "Altura con AUTO_LEVEL y 50000 elementos: " << autoNivel.maxLevel() << endl;
+}
+
+void testShardedSkipList() {
+    cout << "\n========== TEST 25: ShardedSkipList ==========" << endl;
+    
+    ShardedSkipList<int, int> sl(8);
+    map<int, int> referencia;
+    mt19937 rng(11);
+    for (int i = 0; i < 60000; i++) {
+        int k = static_cast<int>(rng() % 30000);
+        if (i % 5 == 4) {
+            bool borrado = sl.remove(k);
+            bool enReferencia = referencia.erase(k) == 1;
+            assert(borrado == enReferencia);
+        } else {
+            sl.insert(k, i);
+            referencia[k] = i;
+        }
+    }
+    sl.rebalance();
+    assert(sl.shard_count() > 1 && sl.size() == referencia.size());
+    
+    // Merge de k vias: mismo orden que std::map
+    auto esperado = referencia.begin();
+    for (auto it = sl.begin(); it != sl.end(); ++it, ++esperado) {
+        assert(it.key() == esperado->first && it.value() == esperado->second);
+    }
+    assert(esperado == referencia.end());
+    
+    int valor;
+    assert(sl.search(referencia.begin()->first, valor) && valor == referencia.begin()->second);
+    sl[-1] = 5;
+    sl[-1] += 1;
+    assert(sl.at(-1) == 6 && sl.contains(-1));
+    
+    // Con maxShards ya alcanzado, rebalance une los dos shards frios y
+    // parte el caliente sin perder ni desordenar entradas
+    ShardedSkipList<int, int> cortes({1000, 2000}, 3);
+    for (int i = 0; i < 10; i++) {
+        cortes.insert(i, i);
+        cortes.insert(1000 + i, i);
+    }
+    for (int i = 0; i < 5000; i++) cortes.insert(2000 + i, i);
+    cortes.rebalance();
+    assert(cortes.shard_count() == 3 && cortes.size() == 5020);
+    int anteriorCorte = -1;
+    size_t vistosCorte = 0;
+    cortes.for_each([&vistosCorte, &anteriorCorte](const int& k, const int&) {
+        assert(k > anteriorCorte);
+        anteriorCorte = k;
+        vistosCorte++;
+    });
+    assert(vistosCorte == 5020);
+    assert(cortes.search(5, valor) && valor == 5 && cortes.search(1009, valor) && valor == 9);
+    assert(cortes.search(4500, valor) && valor == 2500 && !cortes.contains(999));
+    cortes.insert(999, 1);
+    bool borrado = cortes.remove(999);
+    assert(borrado && cortes.size() == 5020);
+    
+    // Escritores en paralelo con rebalanceos automaticos
+    ShardedSkipList<int, int> concurrente(4);
+    vector<thread> hilos;
+    for (int t = 0; t < 4; t++) {
+        hilos.push_back(thread([&concurrente, t]() {
+            for (int i = 0; i < 20000; i++) {
+                concurrente.insert(i * 4 + t, i);
+                if (i % 3 == 0) concurrente.remove(i * 4 + t);
+            }
+        }));
+    }
+    for (auto& h : hilos) h.join();
+    size_t vistos = 0;
+    int anterior = -1;
+    concurrente.for_each([&vistos, &anterior](const int& k, const int&) {
+        assert(k > anterior);
+        anterior = k;
+        vistos++;
+    });
+    assert(vistos == 4 * (20000 - 6667) && concurrente.size() == vistos);
+    
+    // Reparto por hash: shards fijos, recorrido en orden igual
+    ShardedSkipList<int, int, less<int>, hash<int>> porHash(4);
+    for (int i = 0; i < 1000; i++) porHash.insert(i * 3, i);
+    assert(porHash.shard_count() == 4 && porHash.size() == 1000);
+    anterior = -1;
+    size_t total = 0;
+    for (auto it = porHash.begin(); it != porHash.end(); ++it, ++total) {
+        assert(it.key() > anterior);
+        anterior = it.key();
+    }
+    assert(total == 1000);
+    porHash.clear();
+    assert(porHash.empty());
+    cout << "Shards: " << sl.shard_count() << " (rangos), " << concurrente.shard_count()
+         << " tras escrituras concurrentes" << endl;
+}
+
+void testOptimisticSkipList() {
+    cout << "\n========== TEST 26: OptimisticSkipList ==========" << endl;
+    
+    SkipList<int, string> origen;
+    for (int i = 0; i < 100; i++) origen.insert(i, to_string(i));
+    OptimisticSkipList<int, string> osl(origen);
+    assert(osl.size() == 100 && osl.at(42) == "42");
+    
+    bool nuevo = osl.insert(42, "cuarenta y dos");
+    assert(!nuevo && osl.at(42) == "cuarenta y dos");
+    bool borrado = osl.remove(42);
+    assert(borrado && !osl.contains(42));
+    borrado = osl.remove(42);
+    assert(!borrado);
+    nuevo = osl.insert(42, "42");
+    assert(nuevo && osl.size() == 100);
+    bool lanzo = false;
+    try {
+        osl.at(1000);
+    } catch (const out_of_range&) {
+        lanzo = true;
+    }
+    assert(lanzo);
+    int anterior = -1;
+    osl.for_each([&anterior](const int& k, const string& v) {
+        assert(k > anterior && v == to_string(k));
+        anterior = k;
+    });
+    assert(anterior == 99);
+    
+    // Lectores sin locks mientras un escritor inserta, sobrescribe y borra.
+    // Las claves pares nunca se borran y su valor siempre es la clave o su
+    // negativo.
+    OptimisticSkipList<int, int> compartida;
+    for (int i = 0; i < 2000; i += 2) compartida.insert(i, i);
+    atomic<bool> fin(false);
+    atomic<int> errores(0);
+    vector<thread> lectores;
+    for (int t = 0; t < 3; t++) {
+        lectores.push_back(thread([&compartida, &fin, &errores]() {
+            while (!fin.load()) {
+                for (int k = 0; k < 2000; k += 2) {
+                    int v;
+                    if (!compartida.search(k, v) || (v != k && v != -k)) errores++;
+                }
+            }
+        }));
+    }
+    for (int ronda = 0; ronda < 20; ronda++) {
+        for (int k = 1; k < 2000; k += 2) compartida.insert(k, k);
+        for (int k = 0; k < 2000; k += 2) compartida.insert(k, ronda % 2 ? k : -k);
+        for (int k = 1; k < 2000; k += 2) compartida.remove(k);
+    }
+    fin = true;
+    for (auto& h : lectores) h.join();
+    assert(errores == 0 && compartida.size() == 1000);
+    compartida.clear();
+    assert(compartida.empty() && !compartida.contains(0));
+    cout << "Lecturas concurrentes consistentes con 20 rondas de escrituras" << endl;
+}
+
+void testMoveOnly() {
+    cout << "\n========== TEST 27: Tipos solo movibles y extract ==========" << endl;
+    
+    SkipList<int, unique_ptr<string>> origen;
+    SkipList<int, unique_ptr<string>> destino(4);
+    for (int i = 0; i < 1000; i++) {
+        bool insertado = origen.insert(i, unique_ptr<string>(new string(to_string(i))));
+        assert(insertado);
+    }
+    bool insertado = origen.insert(5, unique_ptr<string>(new string("cinco")));
+    assert(!insertado && *origen.at(5) == "cinco");
+    
+    // try_emplace no toca un valor existente; insert_or_assign lo reemplaza
+    auto intento = origen.try_emplace(5);
+    assert(!intento.second && *(*intento.first).second == "cinco");
+    auto nuevo = origen.try_emplace(1000, new string("mil"));
+    assert(nuevo.second && *origen.at(1000) == "mil");
+    auto asignado = origen.insert_or_assign(5, unique_ptr<string>(new string("5")));
+    assert(!asignado.second && *origen.at(5) == "5");
+    
+    // Mover la mitad de las entradas a otra lista sin copiar ni reservar
+    string* direccion = origen.at(10).get();
+    for (int i = 0; i < 1000; i += 2) {
+        auto handle = origen.extract(i);
+        assert(handle && handle.key() == i);
+        auto res = destino.insert(std::move(handle));
+        assert(res.second && handle.empty());
+    }
+    assert(destino.at(10).get() == direccion);
+    assert(origen.size() == 501 && destino.size() == 500);
+    auto vacio = origen.extract(2);
+    assert(vacio.empty());
+    
+    // Clave repetida: el handle conserva el nodo
+    auto handle = origen.extract(1);
+    handle.key() = 0;
+    auto repetido = destino.insert(std::move(handle));
+    assert(!repetido.second && !handle.empty());
+    handle.key() = 1;
+    auto reinsertado = destino.insert(std::move(handle));
+    assert(reinsertado.second);
+    
+    // Los rangos se mantienen con nodos reutilizados
+    for (size_t i = 0; i < destino.size(); i++) {
+        int esperado = i < 2 ? static_cast<int>(i) : static_cast<int>(i - 1) * 2;
+        assert(destino.select(i).key() == esperado && destino.rank(esperado) == i);
+    }
+    auto ultimo = destino.end();
+    --ultimo;
+    assert(ultimo.key() == 998);
+    
+    // Clave solo movible
+    SkipList<unique_ptr<int>, int, function<bool(const unique_ptr<int>&, const unique_ptr<int>&)>> porPuntero(
+        16, 0.5f, [](const unique_ptr<int>& a, const unique_ptr<int>& b) { return *a < *b; });
+    porPuntero.insert(unique_ptr<int>(new int(3)), 3);
+    porPuntero[unique_ptr<int>(new int(1))] = 1;
+    assert(porPuntero.size() == 2 && porPuntero.begin().value() == 1);
+    cout << "Movidas 501 entradas con extract/insert" << endl;
+}
+
+void testSplitJoinMerge() {
+    cout << "\n========== TEST 28: split, join y conjuntos ==========" << endl;
+    
+    auto verificar = [](SkipList<int, int>& sl, const map<int, int>& esperado) {
+        assert(sl.size() == esperado.size());
+        size_t i = 0;
+        auto it = esperado.begin();
+        for (auto nodo = sl.begin(); nodo != sl.end(); ++nodo, ++it, ++i) {
+            assert(nodo.key() == it->first && nodo.value() == it->second);
+            assert(sl.rank(nodo.key()) == i && sl.select(i).key() == nodo.key());
+        }
+        assert(sl.empty() || sl.last().key() == esperado.rbegin()->first);
+    };
+    
+    mt19937 rng(21);
+    SkipList<int, int> a;
+    SkipList<int, int> b;
+    map<int, int> ma;
+    map<int, int> mb;
+    for (int i = 0; i < 2000; i++) {
+        int k = static_cast<int>(rng() % 5000);
+        a.insert(k, k);
+        ma[k] = k;
+        k = static_cast<int>(rng() % 5000);
+        b.insert(k, -k);
+        mb[k] = -k;
+    }
+    
+    // split y join recablean solo el borde
+    SkipList<int, int> altos = a.split(2500);
+    verificar(a, map<int, int>(ma.begin(), ma.lower_bound(2500)));
+    verificar(altos, map<int, int>(ma.lower_bound(2500), ma.end()));
+    a.join(altos);
+    verificar(a, ma);
+    assert(altos.empty());
+    bool lanzo = false;
+    try {
+        SkipList<int, int> menores;
+        menores.insert(-1, 0);
+        a.join(menores);
+    } catch (const invalid_argument&) {
+        lanzo = true;
+    }
+    assert(lanzo && a.size() == ma.size());
+    
+    // Con seed(), la parte que devuelve split tambien es reproducible
+    SkipList<int, int> s1;
+    SkipList<int, int> s2;
+    s1.seed(28);
+    s2.seed(28);
+    for (int i = 0; i < 1000; i++) {
+        s1.insert(i, i);
+        s2.insert(i, i);
+    }
+    SkipList<int, int> p1 = s1.split(500);
+    SkipList<int, int> p2 = s2.split(500);
+    for (int i = 1000; i < 3000; i++) {
+        p1.insert(i, i);
+        p2.insert(i, i);
+    }
+    assert(p1.stats().levelNodes == p2.stats().levelNodes && p1.maxLevel() == p2.maxLevel());
+    
+    // merge: los repetidos quedan en el origen
+    SkipList<int, int> destino(a);
+    SkipList<int, int> origen(b);
+    destino.merge(origen);
+    map<int, int> union1 = ma;
+    map<int, int> repetidos;
+    for (auto& par : mb) {
+        if (!union1.insert(par).second) repetidos.insert(par);
+    }
+    verificar(destino, union1);
+    verificar(origen, repetidos);
+    
+    SkipList<int, int> u(a);
+    SkipList<int, int> otra(b);
+    u.unite(otra);
+    verificar(u, union1);
+    assert(otra.empty());
+    
+    map<int, int> comunes;
+    map<int, int> soloA;
+    for (auto& par : ma) {
+        (mb.count(par.first) ? comunes : soloA).insert(par);
+    }
+    SkipList<int, int> inter(a);
+    inter.intersect(b);
+    verificar(inter, comunes);
+    SkipList<int, int> dif(a);
+    dif.subtract(b);
+    verificar(dif, soloA);
+    
+    // La lista sigue siendo valida para insertar y borrar
+    dif.insert(-7, 7);
+    bool borrado = dif.remove(-7);
+    assert(borrado && dif.size() == soloA.size());
+    cout << "Union: " << union1.size() << ", interseccion: " << comunes.size()
+         << ", diferencia: " << soloA.size() << endl;
+}
+
+void testPriorityQueue() {
+    cout << "\n========== TEST 29: front, pop_front y pop_until ==========" << endl;
+    
+    SkipList<int, string> timers;
+    bool sacado = timers.pop_front();
+    assert(timers.front() == timers.end() && !sacado);
+    mt19937 rng(29);
+    map<int, string> referencia;
+    for (int i = 0; i < 3000; i++) {
+        int t = static_cast<int>(rng() % 100000);
+        timers.insert(t, to_string(t));
+        referencia[t] = to_string(t);
+    }
+    
+    int clave;
+    string tarea;
+    assert(timers.front().key() == referencia.begin()->first);
+    sacado = timers.pop_front(clave, tarea);
+    assert(sacado && clave == referencia.begin()->first && tarea == to_string(clave));
+    referencia.erase(referencia.begin());
+    sacado = timers.pop_front();
+    assert(sacado);
+    referencia.erase(referencia.begin());
+    
+    // Vencidos hasta 50000 inclusive, en orden y en una sola operacion
+    vector<pair<int, string>> vencidos;
+    size_t cuantos = timers.pop_until(50000, back_inserter(vencidos));
+    auto limite = referencia.upper_bound(50000);
+    assert(cuantos == static_cast<size_t>(distance(referencia.begin(), limite)));
+    auto esperado = referencia.begin();
+    for (auto& par : vencidos) {
+        assert(par.first == esperado->first && par.second == esperado->second);
+        ++esperado;
+    }
+    referencia.erase(referencia.begin(), limite);
+    cuantos = timers.pop_until(-1, back_inserter(vencidos));
+    assert(cuantos == 0);
+    
+    assert(timers.size() == referencia.size() && timers.front().key() == referencia.begin()->first);
+    for (size_t i = 0; i < timers.size(); i += 97) {
+        assert(timers.select(i).key() == next(referencia.begin(), static_cast<ptrdiff_t>(i))->first);
+    }
+    auto ultimo = timers.rbegin();
+    assert((*ultimo).first == referencia.rbegin()->first);
+    timers.insert(0, "cero");
+    assert(timers.front().key() == 0);
+    vencidos.clear();
+    timers.pop_until(200000, back_inserter(vencidos));
+    assert(timers.empty() && timers.last() == timers.end() && vencidos.size() == referencia.size() + 1);
+    
+    // Varios consumidores: cada elemento sale exactamente una vez y cada
+    // consumidor lo recibe en orden creciente
+    ConcurrentSkipList<int, int> cola;
+    for (int i = 0; i < 20000; i++) cola.insert(i, i);
+    vector<vector<int>> recibidos(4);
+    vector<thread> consumidores;
+    for (int t = 0; t < 4; t++) {
+        consumidores.push_back(thread([&cola, &recibidos, t]() {
+            int k, v;
+            while (cola.pop_front(k, v)) {
+                assert(k == v);
+                recibidos[static_cast<size_t>(t)].push_back(k);
+            }
+        }));
+    }
+    for (auto& h : consumidores) h.join();
+    vector<int> todos;
+    for (auto& r : recibidos) {
+        assert(is_sorted(r.begin(), r.end()));
+        todos.insert(todos.end(), r.begin(), r.end());
+    }
+    sort(todos.begin(), todos.end());
+    assert(todos.size() == 20000 && cola.empty());
+    for (int i = 0; i < 20000; i++) assert(todos[static_cast<size_t>(i)] == i);
+    cout << "pop_until quito " << cuantos << " timers vencidos" << endl;
+}
+
+void testParallel() {
+    cout << "\n========== TEST 30: copia, construccion y recorridos paralelos ==========" << endl;
+    
+    auto iguales = [](SkipList<int, int>& a, SkipList<int, int>& b) {
+        assert(a.size() == b.size());
+        auto x = a.begin();
+        for (auto y = b.begin(); y != b.end(); ++x, ++y) {
+            assert(x.key() == y.key() && x.value() == y.value());
+        }
+        for (size_t i = 0; i < a.size(); i += 101) {
+            assert(a.select(i).key() == b.select(i).key() && a.rank(a.select(i).key()) == i);
+        }
+        assert(a.empty() || (*a.rbegin()).first == (*b.rbegin()).first);
+    };
+    
+    mt19937 rng(30);
+    SkipList<int, int> origen;
+    for (int i = 0; i < 40000; i++) {
+        int k = static_cast<int>(rng() % 1000000);
+        origen.insert(k, k * 2);
+    }
+    
+    // Copia en 4 hilos: mismos elementos, rangos y enlaces hacia atras
+    SkipList<int, int> copia(origen, 4);
+    iguales(copia, origen);
+    size_t atras = 0;
+    for (auto it = copia.rbegin(); it != copia.rend(); ++it) atras++;
+    assert(atras == origen.size());
+    copia.insert(-5, 0);
+    bool borrado = copia.remove(-5);
+    assert(borrado);
+    borrado = copia.remove(origen.front().key());
+    assert(borrado);
+    assert(copia.size() + 1 == origen.size());
+    
+    SkipList<int, int> chica;
+    chica.insert(1, 1);
+    SkipList<int, int> copiaChica(chica, 8);
+    iguales(copiaChica, chica);
+    
+    // Con SlabAllocator se copia en serie
+    SkipList<int, int, less<int>, SlabAllocator<pair<const int, int>>> slab;
+    for (int i = 0; i < 10000; i++) slab.insert(i, i);
+    SkipList<int, int, less<int>, SlabAllocator<pair<const int, int>>> copiaSlab(slab, 4);
+    assert(copiaSlab.size() == 10000 && copiaSlab.at(9999) == 9999);
+    
+    // Construccion ordenada con repetidos (gana el ultimo), igual que from_sorted
+    vector<pair<int, int>> entrada;
+    for (int i = 0; i < 30000; i++) {
+        entrada.push_back(make_pair(i / 3, i));
+    }
+    SkipList<int, int> serie = SkipList<int, int>::from_sorted(entrada.begin(), entrada.end(), true);
+    SkipList<int, int> paralela = SkipList<int, int>::parallel_from_sorted(entrada.begin(), entrada.end(),
+                                                                           true, 16, 0.5f, 4);
+    iguales(paralela, serie);
+    assert(paralela.size() == 10000 && paralela.at(4096) == 4096 * 3 + 2);
+    assert(paralela.stats().levelNodes == serie.stats().levelNodes && paralela.maxLevel() == serie.maxLevel());
+    SkipList<int, int> aleatoria = SkipList<int, int>::parallel_from_sorted(entrada.begin(), entrada.end(),
+                                                                            false, 16, 0.5f, 4);
+    iguales(aleatoria, serie);
+    swap(entrada[20000], entrada[20001]);
+    swap(entrada[20000], entrada[19990]);
+    bool lanzo = false;
+    try {
+        SkipList<int, int>::parallel_from_sorted(entrada.begin(), entrada.end(), false, 16, 0.5f, 4);
+    } catch (const invalid_argument&) {
+        lanzo = true;
+    }
+    assert(lanzo);
+    
+    // for_each y reduce sobre un rango, comparados con el recorrido en serie
+    long long esperado = 0;
+    size_t enRango = 0;
+    for (auto it = origen.lower_bound(100000); it != origen.lower_bound(900000); ++it) {
+        esperado += it.value();
+        enRango++;
+    }
+    long long suma = origen.parallel_reduce(100000, 900000, 0LL,
+        [](const int&, const int& v) { return static_cast<long long>(v); },
+        [](long long a, long long b) { return a + b; }, 4);
+    assert(suma == esperado);
+    
+    atomic<size_t> visitados(0);
+    copia.parallel_for_each(100000, 900000, [&visitados](const int& k, int& v) {
+        v = -k;
+        visitados++;
+    }, 4);
+    assert(visitados == enRango);
+    assert(copia.parallel_reduce(100000, 900000, true,
+        [](const int& k, const int& v) { return v == -k; },
+        [](bool a, bool b) { return a && b; }, 3));
+    assert(copia.parallel_reduce(5, 5, 0, [](const int&, const int&) { return 1; },
+                                 [](int a, int b) { return a + b; }) == 0);
+    
+    lanzo = false;
+    try {
+        origen.parallel_for_each(0, 1000000, [](const int& k, const int&) {
+            if (k > 500000) throw runtime_error("fallo");
+        }, 4);
+    } catch (const runtime_error&) {
+        lanzo = true;
+    }
+    assert(lanzo);
+    cout << "Copia paralela de " << copia.size() + 1 << " elementos y suma de rango " << suma << endl;
+}
+
+// Reloj que solo avanza cuando el test lo mueve
+struct RelojPrueba {
+    typedef chrono::milliseconds duration;
+    typedef duration::rep rep;
+    typedef duration::period period;
+    typedef chrono::time_point<RelojPrueba> time_point;
+    static const bool is_steady = true;
+    
+    static time_point& actual() {
+        static time_point t;
+        return t;
+    }
+    
+    static time_point now() {
+        return actual();
+    }
+};
+
+void testCacheSkipList() {
+    cout << "\n========== TEST 31: CacheSkipList con TTL y limites ==========" << endl;
+    
+    typedef CacheSkipList<int, string, less<int>, RelojPrueba> Cache;
+    RelojPrueba::actual() = RelojPrueba::time_point();
+    
+    // Expiracion perezosa: la entrada vencida no se ve y se borra al leerla
+    Cache cache;
+    cache.insert(1, "uno", chrono::milliseconds(100));
+    cache.insert(2, "dos");
+    string v;
+    bool hallada = cache.search(1, v);
+    assert(hallada && v == "uno" && cache.at(2) == "dos");
+    RelojPrueba::actual() += chrono::milliseconds(100);
+    // Esta lectura es la que borra la entrada vencida
+    hallada = cache.search(1, v);
+    assert(!hallada && cache.find(1) == nullptr && cache.size() == 1);
+    assert(cache.expirations() == 1 && cache.contains(2));
+    bool lanzo = false;
+    try {
+        cache.at(1);
+    } catch (const out_of_range&) {
+        lanzo = true;
+    }
+    assert(lanzo);
+    
+    // Sobrescribir reemplaza el vencimiento
+    cache.insert(3, "tres", chrono::milliseconds(10));
+    cache.insert(3, "tres!");
+    RelojPrueba::actual() += chrono::milliseconds(50);
+    assert(cache.contains(3) && *cache.find(3) == "tres!");
+    
+    // expire_some trabaja como mucho sobre maxItems entradas vencidas
+    for (int i = 100; i < 400; i++) {
+        cache.insert(i, to_string(i), chrono::milliseconds(i));
+    }
+    RelojPrueba::time_point t = RelojPrueba::now() + chrono::milliseconds(250);
+    size_t barridas = cache.expire_some(t, 64);
+    assert(barridas == 64);
+    barridas = cache.expire_some(t, 64);
+    assert(barridas == 64);
+    barridas = cache.expire_some(t, 1000);
+    assert(barridas == 23);
+    barridas = cache.expire_some(t, 1000);
+    assert(barridas == 0);
+    assert(!cache.contains(250) && cache.contains(251) && cache.size() == 2 + 149);
+    cache.remove(251);
+    barridas = cache.expire_some(RelojPrueba::now() + chrono::seconds(1), 1000);
+    assert(barridas == 148);
+    assert(cache.size() == 2);
+    
+    // Limite de entradas con LRU: leer renueva la entrada
+    CacheOptions lru;
+    lru.maxSize = 3;
+    Cache chica(lru);
+    chica.insert(1, "a");
+    chica.insert(2, "b");
+    chica.insert(3, "c");
+    hallada = chica.contains(1);
+    assert(hallada);
+    chica.insert(4, "d");
+    assert(chica.size() == 3 && chica.evictions() == 1);
+    assert(chica.contains(1) && !chica.contains(2) && chica.contains(3) && chica.contains(4));
+    
+    // FIFO ignora las lecturas; las vencidas salen antes que la victima
+    CacheOptions fifo = lru;
+    fifo.policy = EVICT_FIFO;
+    Cache cola(fifo);
+    cola.insert(1, "a");
+    cola.insert(2, "b", chrono::milliseconds(5));
+    cola.insert(3, "c");
+    hallada = cola.contains(1);
+    assert(hallada);
+    RelojPrueba::actual() += chrono::milliseconds(5);
+    cola.insert(4, "d");
+    assert(cola.evictions() == 0 && cola.expirations() == 1 && cola.contains(1));
+    cola.insert(5, "e");
+    assert(cola.evictions() == 1 && !cola.contains(1) && cola.contains(5));
+    
+    // Limite de bytes con el tamaño de cada valor
+    CacheOptions porBytes;
+    porBytes.maxBytes = 20;
+    Cache pesada(porBytes, [](const int&, const string& s) { return s.size(); });
+    pesada.insert(1, string(8, 'x'));
+    pesada.insert(2, string(8, 'y'));
+    assert(pesada.bytes() == 16);
+    pesada.insert(3, string(8, 'z'));
+    assert(pesada.size() == 2 && pesada.bytes() == 16 && !pesada.contains(1));
+    pesada.insert(2, string(2, 'y'));
+    assert(pesada.bytes() == 10 && pesada.at(2) == "yy");
+    // Una entrada mas pesada que el limite se rechaza sin tocar la cache
+    bool rechazada = false;
+    try {
+        pesada.insert(4, string(21, 'w'));
+    } catch (const invalid_argument&) {
+        rechazada = true;
+    }
+    assert(rechazada && !pesada.contains(4) && pesada.size() == 2 && pesada.bytes() == 10);
+    rechazada = false;
+    try {
+        pesada.insert(2, string(21, 'w'));
+    } catch (const invalid_argument&) {
+        rechazada = true;
+    }
+    assert(rechazada && pesada.at(2) == "yy" && pesada.bytes() == 10);
+    pesada.insert(4, string(20, 'w'));
+    assert(pesada.size() == 1 && pesada.bytes() == 20 && pesada.contains(4));
+    
+    // Comparado con un map bajo una carga mixta con TTL y limite
+    CacheOptions mixta;
+    mixta.maxSize = 500;
+    Cache grande(mixta);
+    mt19937 rng(31);
+    for (int paso = 0; paso < 20000; paso++) {
+        RelojPrueba::actual() += chrono::milliseconds(1);
+        int k = static_cast<int>(rng() % 2000);
+        int ttl = rng() % 3 == 0 ? static_cast<int>(rng() % 400) : -1;
+        if (ttl >= 0) {
+            grande.insert(k, to_string(paso), chrono::milliseconds(ttl));
+        } else {
+            grande.insert(k, to_string(paso));
+        }
+        if (paso % 50 == 0) grande.expire_some(RelojPrueba::now(), 16);
+        assert(grande.size() <= 500);
+        // La recien insertada es la mas reciente: solo falta si vencio ya
+        string valor;
+        bool encontrada = grande.search(k, valor);
+        assert(encontrada == (ttl != 0) && (!encontrada || valor == to_string(paso)));
+    }
+    assert(grande.evictions() > 0 && grande.expirations() > 0);
+    assert(grande.bytes() == grande.size() * (sizeof(int) + sizeof(string)));
+    grande.expire_some(RelojPrueba::now() + chrono::seconds(1), 1000);
+    size_t desalojadas = grande.evictions();
+    grande.clear();
+    assert(grande.empty() && grande.bytes() == 0 && grande.evictions() == desalojadas);
+    // Tras clear el limite y el orden de desalojo siguen funcionando
+    for (int i = 0; i < 600; i++) grande.insert(i, "v");
+    assert(grande.size() == 500 && !grande.contains(99) && grande.contains(100));
+    cout << "Desalojadas: " << grande.evictions() << ", vencidas: " << grande.expirations() << endl;
+}
+
 int main() {
     cout << "╔════════════════════════════════════════════════════════════╗" << endl;
     cout << "║     SKIP LIST ROBUSTA - Suite de Pruebas Completa        ║" << endl;
@@ -265,6 +1864,27 @@ int main() {
     testSwap();
     testCustomComparator();
     testLargeDataset();
+    testSlabAllocator();
+    testConcurrentSkipList();
+    testRangeQueries();
+    testOrderStatistics();
+    testBulkLoad();
+    testFingerSearch();
+    testUnrolledSkipList();
+    testMultiFind();
+    testSnapshots();
+    testPersistence();
+    testDurableSkipList();
+    testReverseIteration();
+    testStats();
+    testLevelGenerator();
+    testShardedSkipList();
+    testOptimisticSkipList();
+    testMoveOnly();
+    testSplitJoinMerge();
+    testPriorityQueue();
+    testParallel();
+    testCacheSkipList();
     
     cout << "\n╔════════════════════════════════════════════════════════════╗" << endl;
     cout << "║              TODOS LOS TESTS COMPLETADOS ✓                ║" << endl;